@@ -0,0 +1,170 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "broadcast.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace cracl
+{
+
+broadcast::broadcast(size_t slots, size_t slot_size)
+  : m_slot_count (slots), m_slot_words ((slot_size + 7) / 8),
+  m_slots (slots), m_words (slots * m_slot_words), m_head (0),
+  m_oversized (0), m_waiting (0)
+{
+  if (slots == 0)
+    throw std::runtime_error("Broadcast ring needs at least one slot");
+
+  for (auto& s : m_slots)
+    s.clear();
+
+  for (auto& word : m_words)
+    word.store(0, std::memory_order_relaxed);
+}
+
+bool broadcast::publish(const uint8_t* frame, size_t size,
+    clock::time_point arrival)
+{
+  if (size > m_slot_words * 8)
+  {
+    m_oversized.fetch_add(1, std::memory_order_relaxed);
+
+    return false;
+  }
+
+  const uint64_t position = m_head.load(std::memory_order_relaxed);
+
+  m_slots[position % m_slot_count].store(
+      &m_words[position % m_slot_count * m_slot_words], 2 * position + 2,
+      frame, size, 0, std::chrono::duration_cast<std::chrono::nanoseconds>(
+        arrival.time_since_epoch()).count());
+
+  m_head.store(position + 1, std::memory_order_release);
+
+  // Only pay for a notification while a consumer is blocked in wait(). The
+  //   fence orders the head update before the check, pairing with wait()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (m_waiting.load(std::memory_order_relaxed) != 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_published.notify_all();
+  }
+
+  return true;
+}
+
+broadcast::cursor broadcast::subscribe()
+{
+  return cursor(*this);
+}
+
+uint64_t broadcast::published() const
+{
+  return m_head.load(std::memory_order_acquire);
+}
+
+uint64_t broadcast::oversized() const
+{
+  return m_oversized.load(std::memory_order_relaxed);
+}
+
+broadcast::cursor::cursor(broadcast& ring)
+  : m_ring (&ring), m_position (ring.published()), m_overruns (0)
+{ }
+
+bool broadcast::cursor::next(uint8_t* buffer, size_t buffer_size,
+    size_t& size, clock::time_point* arrival)
+{
+  while (true)
+  {
+    const uint64_t head = m_ring->m_head.load(std::memory_order_acquire);
+
+    if (m_position >= head)
+      return false;
+
+    // Fell more than a ring behind, skip to the oldest frame that isn't
+    //   about to be overwritten
+    if (head - m_position >= m_ring->m_slot_count)
+    {
+      const uint64_t oldest = head - m_ring->m_slot_count + 1;
+
+      m_overruns += oldest - m_position;
+      m_position = oldest;
+    }
+
+    const size_t index = m_position % m_ring->m_slot_count;
+
+    int64_t ns;
+
+    // A different sequence means the frame was overwritten since head was
+    //   read, catch up
+    if (m_ring->m_slots[index].load(&m_ring->m_words[index
+          * m_ring->m_slot_words], buffer, buffer_size, size, nullptr, &ns)
+        != 2 * m_position + 2)
+      continue;
+
+    if (arrival)
+      *arrival = clock::time_point(std::chrono::duration_cast<
+          clock::duration>(std::chrono::nanoseconds(ns)));
+
+    ++m_position;
+
+    return true;
+  }
+}
+
+bool broadcast::cursor::wait(size_t timeout)
+{
+  if (available() != 0)
+    return true;
+
+  std::unique_lock<std::mutex> lock(m_ring->m_mutex);
+
+  m_ring->m_waiting.fetch_add(1, std::memory_order_seq_cst);
+
+  const bool published = m_ring->m_published.wait_for(lock,
+      std::chrono::milliseconds(timeout),
+      [this]() { return available() != 0; });
+
+  m_ring->m_waiting.fetch_sub(1, std::memory_order_seq_cst);
+
+  return published;
+}
+
+uint64_t broadcast::cursor::available() const
+{
+  return m_ring->m_head.load(std::memory_order_acquire) - m_position;
+}
+
+uint64_t broadcast::cursor::overruns() const
+{
+  return m_overruns;
+}
+
+} // namespace cracl
@@ -0,0 +1,139 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_BROADCAST_HPP
+#define CRACL_BASE_BROADCAST_HPP
+
+#include "frame_slot.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace cracl
+{
+
+/* @brief Fixed size ring of frames published by one thread and read by any
+ *        number of consumers, each with its own cursor
+ *
+ * The producer never waits for consumers. A consumer that falls more than a
+ * ring behind skips ahead to the oldest frame still held and has the frames
+ * it missed counted as overruns. Each slot is guarded by a sequence number so
+ * consumers read without locking; waiting for new frames is optional and
+ * only costs the producer a notification while somebody waits.
+ */
+class broadcast
+{
+public:
+  typedef std::chrono::system_clock clock;
+
+private:
+  size_t m_slot_count;
+  size_t m_slot_words;
+
+  // Frame at position p is held in slot p % m_slot_count with sequence
+  //   2 * (p + 1)
+  std::vector<frame_slot> m_slots;
+  std::vector<std::atomic<uint64_t>> m_words;
+
+  std::atomic<uint64_t> m_head;
+  std::atomic<uint64_t> m_oversized;
+
+  std::atomic<size_t> m_waiting;
+  std::mutex m_mutex;
+  std::condition_variable m_published;
+
+public:
+  class cursor
+  {
+    broadcast* m_ring;
+
+    uint64_t m_position;
+    uint64_t m_overruns;
+
+  public:
+    cursor(broadcast& ring);
+
+    /* @brief Copy the next frame into a buffer
+     *
+     * @param size Set to the size of the frame, which is only partly copied
+     *        if larger than the buffer
+     * @param arrival Set to the time the frame was published, if given
+     *
+     * @return False if no new frame has been published
+     */
+    bool next(uint8_t* buffer, size_t buffer_size, size_t& size,
+        clock::time_point* arrival=nullptr);
+
+    /* @brief Block until a new frame is published or the timeout expires
+     *
+     * @param timeout Time in milliseconds to wait
+     *
+     * @return True if a frame is available
+     */
+    bool wait(size_t timeout);
+
+    /* @brief Frames published but not yet read (including any that will be
+     *        skipped as overruns)
+     */
+    uint64_t available() const;
+
+    /* @brief Frames skipped because the consumer fell behind
+     */
+    uint64_t overruns() const;
+
+  };
+
+  /* @param slots Number of frames held
+   * @param slot_size Largest frame held, in bytes
+   */
+  broadcast(size_t slots=256, size_t slot_size=2048);
+
+  broadcast(const broadcast&) = delete;
+
+  broadcast& operator=(const broadcast&) = delete;
+
+  /* @brief Publish a frame to every cursor (single producer only)
+   *
+   * @return False if the frame is larger than a slot and was not published
+   */
+  bool publish(const uint8_t* frame, size_t size,
+      clock::time_point arrival=clock::now());
+
+  /* @brief Cursor positioned after the newest frame published so far
+   */
+  cursor subscribe();
+
+  /* @brief Number of frames published so far
+   */
+  uint64_t published() const;
+
+  /* @brief Frames not published because they were larger than a slot
+   */
+  uint64_t oversized() const;
+
+};
+
+} // namespace cracl
+
+#endif // CRACL_BASE_BROADCAST_HPP
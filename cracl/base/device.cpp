@@ -20,6 +20,7 @@
 //   coltonriedel at protonmail dot ch
 
 #include "device.hpp"
+#include "termios2.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
@@ -30,6 +31,10 @@
 #include <mutex>
 #include <string>
 
+#ifndef _WIN32
+#include <termios.h>
+#endif
+
 namespace cracl
 {
 
@@ -37,7 +42,8 @@ device::device(const std::string& location, size_t baud_rate, size_t timeout,
     size_t char_size, std::string delim, size_t max_handlers,
     port_base::parity::type parity, port_base::flow_control::type flow_control,
     port_base::stop_bits::type stop_bits)
-  : m_timeout(timeout), m_max_handlers(max_handlers), m_location(location),
+  : m_timeout(timeout), m_baud_rate(baud_rate), m_bytes_read(0),
+    m_bytes_written(0), m_max_handlers(max_handlers), m_location(location),
     m_delim(std::move(delim)), m_io(), m_port(m_io), m_timer(m_io)
 {
   // Create a shared pointer to this instance so that we can track the number of
@@ -49,7 +55,7 @@ device::device(const std::string& location, size_t baud_rate, size_t timeout,
 
   m_port.open(m_location);
 
-  m_port.set_option(port_base::baud_rate(baud_rate));
+  apply_baud_rate();
   m_port.set_option(port_base::character_size(char_size));
   m_port.set_option(port_base::parity(parity));
   m_port.set_option(port_base::flow_control(flow_control));
@@ -107,13 +113,11 @@ void device::flush_handlers()
 
   m_io.stop();
 
-  port_base::baud_rate baud_rate;
   port_base::character_size char_size;
   port_base::parity parity;
   port_base::flow_control flow_control;
   port_base::stop_bits stop_bits;
 
-  m_port.get_option(baud_rate);
   m_port.get_option(char_size);
   m_port.get_option(parity);
   m_port.get_option(flow_control);
@@ -141,7 +145,9 @@ void device::flush_handlers()
 
   m_port.open(m_location);
 
-  m_port.set_option(baud_rate);
+  // Baud rate is reapplied from the stored value, since Boost cannot read back
+  //   a non-standard rate
+  apply_baud_rate();
   m_port.set_option(char_size);
   m_port.set_option(parity);
   m_port.set_option(flow_control);
@@ -155,11 +161,65 @@ void device::flush_handlers()
   new (&m_timer) boost::asio::deadline_timer(m_io);
 }
 
+void device::apply_baud_rate()
+{
+  boost::system::error_code error;
+
+  m_port.set_option(port_base::baud_rate(m_baud_rate), error);
+
+#ifdef __linux__
+  if (error && termios2::set_baud_rate(m_port.native_handle(), m_baud_rate))
+    error = boost::system::error_code();
+#endif
+
+  if (error)
+    throw std::runtime_error(std::string("Unsupported baud rate: "
+          + std::to_string(m_baud_rate)));
+}
+
+const std::string& device::location()
+{
+  return m_location;
+}
+
+size_t device::baud_rate()
+{
+  return m_baud_rate;
+}
+
 void device::baud_rate(size_t baud_rate)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  m_port.set_option(port_base::baud_rate(baud_rate));
+  m_baud_rate = baud_rate;
+
+  apply_baud_rate();
+
+  // Anything already received was sent at the old rate
+  m_buf.consume(m_buf.size());
+
+#ifndef _WIN32
+  tcflush(m_port.native_handle(), TCIFLUSH);
+#endif
+}
+
+void device::drain()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+#ifndef _WIN32
+  tcdrain(m_port.native_handle());
+#endif
+}
+
+uint64_t device::bytes_read()
+{
+  return m_bytes_read;
+}
+
+uint64_t device::bytes_written()
+{
+  return m_bytes_written;
 }
 
 size_t device::timeout()
@@ -179,8 +239,9 @@ void device::write(const char* data, size_t size)
 
   std::lock_guard<std::mutex> lock(m_mutex);
 
-
   boost::asio::write(m_port, boost::asio::buffer(data, size));
+
+  m_bytes_written += size;
 }
 
 void device::write(const std::vector<uint8_t>& data)
@@ -191,6 +252,8 @@ void device::write(const std::vector<uint8_t>& data)
   std::lock_guard<std::mutex> lock(m_mutex);
 
   boost::asio::write(m_port, boost::asio::buffer(data.data(), data.size()));
+
+  m_bytes_written += data.size();
 }
 
 void device::write(const std::vector<char>& data)
@@ -201,6 +264,8 @@ void device::write(const std::vector<char>& data)
   std::lock_guard<std::mutex> lock(m_mutex);
 
   boost::asio::write(m_port, boost::asio::buffer(data.data(), data.size()));
+
+  m_bytes_written += data.size();
 }
 
 void device::write(const std::string& data)
@@ -211,6 +276,8 @@ void device::write(const std::string& data)
   std::lock_guard<std::mutex> lock(m_mutex);
 
   boost::asio::write(m_port, boost::asio::buffer(data.c_str(), data.size()));
+
+  m_bytes_written += data.size();
 }
 
 std::vector<uint8_t> device::read()
@@ -250,6 +317,8 @@ std::vector<uint8_t> device::read()
 
       is.read(data, m_read_size);
 
+      m_bytes_read += m_read_size;
+
       break;
     }
     else if (m_read_status == read_status::timeout)
@@ -267,6 +336,13 @@ std::vector<uint8_t> device::read()
     }
   }
 
+  // Complete whichever operation is still outstanding before returning, so a
+  //   stale read can't swallow bytes meant for the next call
+  m_timer.cancel();
+  m_port.cancel();
+
+  m_io.reset();
+  m_io.poll();
   m_io.reset();
 
   return m_result_vector;
@@ -291,6 +367,8 @@ std::vector<uint8_t> device::read(size_t size)
 
     is.read(data, toRead);
 
+    m_bytes_read += toRead;
+
     data += toRead;
     size -= toRead;
   }
@@ -337,7 +415,16 @@ std::vector<uint8_t> device::read(size_t size)
       }
     }
 
+    // Complete whichever operation is still outstanding before returning, so a
+    //   stale read can't swallow bytes meant for the next call
+    m_timer.cancel();
+    m_port.cancel();
+
+    m_io.reset();
+    m_io.poll();
     m_io.reset();
+
+    m_bytes_read += m_read_size;
   }
 
   return m_result_vector;
@@ -357,6 +444,8 @@ uint8_t device::read_byte()
     std::istream is(&m_buf);
 
     is.read(reinterpret_cast<char*> (&m_result_byte), 1);
+
+    ++m_bytes_read;
   }
   else
   {
@@ -400,7 +489,16 @@ uint8_t device::read_byte()
       }
     }
 
+    // Complete whichever operation is still outstanding before returning, so a
+    //   stale read can't swallow bytes meant for the next call
+    m_timer.cancel();
+    m_port.cancel();
+
+    m_io.reset();
+    m_io.poll();
     m_io.reset();
+
+    m_bytes_read += m_read_size;
   }
 
   return m_result_byte;
@@ -40,6 +40,9 @@ enum read_status { ongoing, finalized, error, timeout };
 class device
 {
   size_t m_timeout;
+  size_t m_baud_rate;
+  uint64_t m_bytes_read;
+  uint64_t m_bytes_written;
   size_t m_read_size;
   size_t m_max_handlers;
   read_status m_read_status;
@@ -70,6 +73,11 @@ class device
    */
   void flush_handlers();
 
+  /* @brief Apply m_baud_rate to the port, falling back to termios2 for rates
+   *        Boost ASIO does not know about (caller must hold m_mutex)
+   */
+  void apply_baud_rate();
+
 public:
   device(const std::string& location, size_t baud_rate=115200,
       size_t timeout=100, size_t char_size=8, std::string delim="\r\n",
@@ -80,8 +88,28 @@ public:
 
   inline size_t handler_count() { return m_this.use_count() - 1; };
 
+  /* @brief Path the port was opened from
+   */
+  const std::string& location();
+
+  size_t baud_rate();
+
+  /* @brief Change the host baud rate. Non-standard rates are supported on
+   *        Linux. Input received before the change is discarded
+   */
   void baud_rate(size_t baud_rate);
 
+  /* @brief Block until everything written so far has left the port
+   */
+  void drain();
+
+  /* @brief Running totals of bytes delivered by the read functions and
+   *        bytes written, for measuring link utilization
+   */
+  uint64_t bytes_read();
+
+  uint64_t bytes_written();
+
   size_t timeout();
 
   void timeout(size_t timeout);
@@ -0,0 +1,100 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "frame_slot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace cracl
+{
+
+void frame_slot::clear()
+{
+  sequence.store(0, std::memory_order_relaxed);
+  size.store(0, std::memory_order_relaxed);
+  tag.store(0, std::memory_order_relaxed);
+  arrival.store(0, std::memory_order_relaxed);
+}
+
+void frame_slot::store(std::atomic<uint64_t>* words, uint64_t sequence,
+    const uint8_t* frame, size_t size, uint32_t tag, int64_t arrival)
+{
+  this->sequence.store(sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  this->size.store(static_cast<uint32_t>(size), std::memory_order_relaxed);
+  this->tag.store(tag, std::memory_order_relaxed);
+  this->arrival.store(arrival, std::memory_order_relaxed);
+
+  for (size_t i = 0; i < size; i += 8)
+  {
+    uint64_t word = 0;
+
+    std::memcpy(&word, frame + i, std::min<size_t>(8, size - i));
+
+    words[i / 8].store(word, std::memory_order_relaxed);
+  }
+
+  this->sequence.store(sequence, std::memory_order_release);
+}
+
+uint64_t frame_slot::load(const std::atomic<uint64_t>* words,
+    uint8_t* buffer, size_t buffer_size, size_t& size, uint32_t* tag,
+    int64_t* arrival) const
+{
+  while (true)
+  {
+    const uint64_t before = sequence.load(std::memory_order_acquire);
+
+    if (before & 1)
+      continue;
+
+    size = this->size.load(std::memory_order_relaxed);
+
+    const uint32_t t = this->tag.load(std::memory_order_relaxed);
+    const int64_t a = this->arrival.load(std::memory_order_relaxed);
+    const size_t copy = std::min(size, buffer_size);
+
+    for (size_t i = 0; i < copy; i += 8)
+    {
+      const uint64_t word = words[i / 8].load(std::memory_order_relaxed);
+
+      std::memcpy(buffer + i, &word, std::min<size_t>(8, copy - i));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (sequence.load(std::memory_order_relaxed) != before)
+      continue;
+
+    if (tag)
+      *tag = t;
+
+    if (arrival)
+      *arrival = a;
+
+    return before;
+  }
+}
+
+} // namespace cracl
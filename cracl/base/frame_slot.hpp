@@ -0,0 +1,82 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_FRAME_SLOT_HPP
+#define CRACL_BASE_FRAME_SLOT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cracl
+{
+
+/* @brief A frame guarded by a sequence lock, written by one thread and read
+ *        by any number of others
+ *
+ * Lock-free for the writer; readers retry. The writer never waits, while a
+ * reader that overlaps a write spins until the write finishes and copies the
+ * frame again, so readers can be held up by a busy writer.
+ *
+ * The frame itself is held in separately allocated atomic words (so that a
+ * read overlapping a write is well defined), allowing slots of any size to
+ * share one layout, including in shared memory. The slot is plain data and
+ * may be placed in memory shared between processes.
+ */
+struct frame_slot
+{
+  // Even once written, odd while a write is in progress
+  std::atomic<uint64_t> sequence;
+
+  std::atomic<uint32_t> size;
+
+  // Free for the owner to use, e.g. the kind of frame
+  std::atomic<uint32_t> tag;
+
+  // Nanoseconds since the epoch of the clock used by the owner
+  std::atomic<int64_t> arrival;
+
+  void clear();
+
+  /* @brief Write a frame (single writer only)
+   *
+   * @param words Storage for the frame, at least (size + 7) / 8 words
+   * @param sequence Even sequence number to mark the frame with, greater
+   *        than any used before
+   */
+  void store(std::atomic<uint64_t>* words, uint64_t sequence,
+      const uint8_t* frame, size_t size, uint32_t tag=0, int64_t arrival=0);
+
+  /* @brief Copy out the frame, retrying if it changes during the copy
+   *
+   * @param size Set to the size of the frame, which is only partly copied if
+   *        larger than the buffer
+   *
+   * @return Sequence number of the frame copied
+   */
+  uint64_t load(const std::atomic<uint64_t>* words, uint8_t* buffer,
+      size_t buffer_size, size_t& size, uint32_t* tag=nullptr,
+      int64_t* arrival=nullptr) const;
+
+};
+
+} // namespace cracl
+
+#endif // CRACL_BASE_FRAME_SLOT_HPP
@@ -0,0 +1,947 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "nmea.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cracl
+{
+
+namespace nmea
+{
+
+namespace
+{
+
+const char hex_digits[] = "0123456789ABCDEF";
+
+const uint64_t powers_of_ten[] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+  10000000, 100000000, 1000000000 };
+
+// Exact powers of ten, dividing by one of these rounds correctly as long as
+//   the mantissa fits in a double's 53 bits
+const double exact_powers_of_ten[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+  1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+
+/* @brief Shared digit scanner, returns the number of digits (0 on failure)
+ */
+size_t scan(const token& field, bool& negative, uint64_t& mantissa,
+    size_t& decimals)
+{
+  const char* ch = field.data;
+  const char* end = field.data + field.size;
+
+  negative = false;
+  mantissa = 0;
+  decimals = 0;
+
+  if (ch != end && (*ch == '-' || *ch == '+'))
+    negative = *ch++ == '-';
+
+  size_t digits = 0;
+  bool point = false;
+
+  for (; ch != end; ++ch)
+  {
+    if (*ch >= '0' && *ch <= '9')
+    {
+      // More digits than fit in the mantissa aren't produced by receivers
+      if (++digits > 18)
+        return 0;
+
+      mantissa = mantissa * 10 + (*ch - '0');
+
+      decimals += point;
+    }
+    else if (*ch == '.' && !point)
+      point = true;
+    else
+      return 0;
+  }
+
+  return digits;
+}
+
+int hex_value(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  else if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  else if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+
+  return -1;
+}
+
+} // namespace
+
+sentence::sentence(const char* address, char start)
+{
+  reset(address, start);
+}
+
+void sentence::reset(const char* address, char start)
+{
+  m_size = 0;
+
+  m_data[m_size++] = start;
+
+  // The start character is not part of the checksum
+  m_checksum = 0;
+
+  for (const char* ch = address; *ch != 0x00; ++ch)
+    put(*ch);
+}
+
+void sentence::put_unsigned(uint64_t value)
+{
+  char digits[20];
+  size_t count = 0;
+
+  do
+  {
+    digits[count++] = '0' + (value % 10);
+    value /= 10;
+  }
+  while (value != 0);
+
+  while (count != 0)
+    put(digits[--count]);
+}
+
+sentence& sentence::field(const char* value)
+{
+  put(',');
+
+  for (const char* ch = value; *ch != 0x00; ++ch)
+    put(*ch);
+
+  return *this;
+}
+
+sentence& sentence::field(const std::string& value)
+{
+  return field(value.c_str());
+}
+
+sentence& sentence::field(char value)
+{
+  put(',');
+  put(value);
+
+  return *this;
+}
+
+sentence& sentence::field(double value, size_t decimals)
+{
+  if (decimals >= sizeof (powers_of_ten) / sizeof (powers_of_ten[0]))
+    throw std::runtime_error("Too many decimal places for NMEA field");
+
+  put(',');
+
+  // Non-finite values are left as an empty (null) field
+  if (!std::isfinite(value))
+    return *this;
+
+  const uint64_t scale = powers_of_ten[decimals];
+  const double scaled = std::round(std::fabs(value) * scale);
+
+  if (scaled >= 18446744073709551616.0) // 2^64
+    throw std::runtime_error("Value out of range for NMEA field");
+
+  const uint64_t fixed = static_cast<uint64_t>(scaled);
+
+  if (value < 0 && fixed != 0)
+    put('-');
+
+  put_unsigned(fixed / scale);
+
+  if (decimals != 0)
+  {
+    put('.');
+
+    uint64_t fraction = fixed % scale;
+
+    // Every fractional digit, including any leading zeros
+    for (uint64_t digit = scale / 10; digit > 0; digit /= 10)
+    {
+      put('0' + (fraction / digit));
+      fraction %= digit;
+    }
+  }
+
+  return *this;
+}
+
+sentence& sentence::hex_field(uint8_t value)
+{
+  put(',');
+  put(hex_digits[value >> 4]);
+  put(hex_digits[value & 0x0f]);
+
+  return *this;
+}
+
+void sentence::finish()
+{
+  const uint8_t checksum = m_checksum;
+
+  put('*');
+  put(hex_digits[checksum >> 4]);
+  put(hex_digits[checksum & 0x0f]);
+  put('\r');
+  put('\n');
+
+  m_checksum = checksum;
+}
+
+const char* sentence::data() const
+{
+  return m_data.data();
+}
+
+size_t sentence::size() const
+{
+  return m_size;
+}
+
+uint8_t sentence::checksum() const
+{
+  return m_checksum;
+}
+
+bool token::operator==(const char* value) const
+{
+  size_t i = 0;
+
+  for (; i < size; ++i)
+    if (value[i] == 0x00 || value[i] != data[i])
+      return false;
+
+  return value[i] == 0x00;
+}
+
+bool number(const token& field, double& value)
+{
+  bool negative;
+  uint64_t mantissa;
+  size_t decimals;
+
+  if (scan(field, negative, mantissa, decimals) == 0)
+    return false;
+
+  value = static_cast<double>(mantissa) / exact_powers_of_ten[decimals];
+
+  if (negative)
+    value = -value;
+
+  return true;
+}
+
+bool number(const token& field, int64_t& value)
+{
+  bool negative;
+  uint64_t mantissa;
+  size_t decimals;
+
+  if (scan(field, negative, mantissa, decimals) == 0 || decimals != 0)
+    return false;
+
+  value = negative ? -static_cast<int64_t>(mantissa)
+    : static_cast<int64_t>(mantissa);
+
+  return true;
+}
+
+bool number(const token& field, uint64_t& value)
+{
+  bool negative;
+  uint64_t mantissa;
+  size_t decimals;
+
+  if (scan(field, negative, mantissa, decimals) == 0 || decimals != 0
+      || negative)
+    return false;
+
+  value = mantissa;
+
+  return true;
+}
+
+double decimal(const token& field)
+{
+  double value = std::numeric_limits<double>::quiet_NaN();
+
+  number(field, value);
+
+  return value;
+}
+
+int64_t integer(const token& field, int64_t fallback)
+{
+  int64_t value = fallback;
+
+  number(field, value);
+
+  return value;
+}
+
+double coordinate(const token& value, const token& direction)
+{
+  double ddmm;
+
+  if (!number(value, ddmm))
+    return std::numeric_limits<double>::quiet_NaN();
+
+  const double degrees = std::floor(ddmm / 100);
+  const double result = degrees + (ddmm - degrees * 100) / 60;
+
+  return direction.character() == 'S' || direction.character() == 'W'
+    ? -result : result;
+}
+
+utc_time utc_time::parse(const token& field)
+{
+  utc_time t = { false, 0, 0, 0 };
+
+  double seconds;
+
+  if (field.size >= 6 && number(token{ field.data + 4, field.size - 4 },
+        seconds))
+  {
+    uint64_t hour, minute;
+
+    if (number(token{ field.data, 2 }, hour)
+        && number(token{ field.data + 2, 2 }, minute))
+    {
+      t.valid = true;
+      t.hour = hour;
+      t.minute = minute;
+      t.second = seconds;
+    }
+  }
+
+  return t;
+}
+
+utc_date utc_date::parse(const token& field)
+{
+  utc_date d = { false, 0, 0, 0 };
+
+  uint64_t day, month, year;
+
+  if (field.size == 6 && number(token{ field.data, 2 }, day)
+      && number(token{ field.data + 2, 2 }, month)
+      && number(token{ field.data + 4, 2 }, year))
+  {
+    d.valid = true;
+    d.day = day;
+    d.month = month;
+    d.year = 2000 + year;
+  }
+
+  return d;
+}
+
+tokenizer::tokenizer()
+  : m_data(nullptr), m_count(0)
+{ }
+
+bool tokenizer::parse(const char* data, size_t size)
+{
+  m_data = data;
+  m_count = 0;
+
+  while (size > 0 && (data[size - 1] == '\r' || data[size - 1] == '\n'))
+    --size;
+
+  if (size < 5 || size > max_length || (data[0] != '$' && data[0] != '!')
+      || data[size - 3] != '*')
+    return false;
+
+  const int high = hex_value(data[size - 2]);
+  const int low = hex_value(data[size - 1]);
+
+  if (high < 0 || low < 0)
+    return false;
+
+  // Checksum covers everything between the start character and the '*'
+  const size_t end = size - 3;
+
+  uint8_t checksum = 0;
+
+  for (size_t i = 1; i < end; ++i)
+    checksum ^= static_cast<uint8_t>(data[i]);
+
+  if (checksum != ((high << 4) | low))
+    return false;
+
+  m_start[m_count++] = 1;
+
+  for (size_t i = 1; i < end; ++i)
+    if (data[i] == ',')
+    {
+      if (m_count == max_fields)
+        return false;
+
+      m_start[m_count++] = i + 1;
+    }
+
+  // Past the end of the last field, as if it were followed by a comma
+  m_start[m_count] = end + 1;
+
+  return true;
+}
+
+bool tokenizer::parse(const std::vector<uint8_t>& message)
+{
+  return parse(reinterpret_cast<const char*>(message.data()),
+      message.size());
+}
+
+size_t tokenizer::size() const
+{
+  return m_count;
+}
+
+token tokenizer::operator[](size_t i) const
+{
+  if (i >= m_count)
+    return token{ m_data, 0 };
+
+  return token{ m_data + m_start[i],
+    static_cast<size_t>(m_start[i + 1] - m_start[i] - 1) };
+}
+
+bool tokenizer::is(const char* formatter) const
+{
+  const token address = (*this)[0];
+
+  return address.size == 5
+    && token{ address.data + 2, 3 } == formatter;
+}
+
+bool tokenizer::is_pubx(uint8_t msg_id) const
+{
+  const token id = (*this)[1];
+
+  return (*this)[0] == "PUBX" && id.size == 2
+    && hex_value(id.data[0]) == (msg_id >> 4)
+    && hex_value(id.data[1]) == (msg_id & 0x0f);
+}
+
+std::array<char, 3> tokenizer::talker() const
+{
+  const token address = (*this)[0];
+
+  std::array<char, 3> id = {{ 0x00, 0x00, 0x00 }};
+
+  if (address.size == 5)
+  {
+    id[0] = address.data[0];
+    id[1] = address.data[1];
+  }
+
+  return id;
+}
+
+gga::gga(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool gga::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool gga::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool gga::update(const tokenizer& fields)
+{
+  if (!fields.is("GGA"))
+    return false;
+
+  m_talker = fields.talker();
+  m_time = utc_time::parse(fields[1]);
+  m_lat = coordinate(fields[2], fields[3]);
+  m_lon = coordinate(fields[4], fields[5]);
+  m_quality = integer(fields[6]);
+  m_numSV = integer(fields[7]);
+  m_hdop = decimal(fields[8]);
+  m_alt = decimal(fields[9]);
+  m_sep = decimal(fields[11]);
+  m_diffAge = decimal(fields[13]);
+  m_diffStation = integer(fields[14]);
+
+  return true;
+}
+
+bool gga::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("GGA");
+}
+
+rmc::rmc(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool rmc::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool rmc::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool rmc::update(const tokenizer& fields)
+{
+  if (!fields.is("RMC"))
+    return false;
+
+  m_talker = fields.talker();
+  m_time = utc_time::parse(fields[1]);
+  m_status = fields[2].character();
+  m_lat = coordinate(fields[3], fields[4]);
+  m_lon = coordinate(fields[5], fields[6]);
+  m_spd = decimal(fields[7]);
+  m_cog = decimal(fields[8]);
+  m_date = utc_date::parse(fields[9]);
+  m_posMode = fields[12].character();
+  m_navStatus = fields[13].character();
+
+  // Magnetic variation is plain degrees, not ddmm
+  m_mv = decimal(fields[10]);
+
+  if (fields[11].character() == 'W')
+    m_mv = -m_mv;
+
+  return true;
+}
+
+bool rmc::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("RMC");
+}
+
+zda::zda(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool zda::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool zda::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool zda::update(const tokenizer& fields)
+{
+  if (!fields.is("ZDA"))
+    return false;
+
+  m_talker = fields.talker();
+  m_time = utc_time::parse(fields[1]);
+
+  int64_t day = integer(fields[2]);
+  int64_t month = integer(fields[3]);
+  int64_t year = integer(fields[4]);
+
+  m_date.valid = !fields[2].empty() && !fields[3].empty()
+    && !fields[4].empty();
+  m_date.day = day;
+  m_date.month = month;
+  m_date.year = year;
+
+  m_ltzh = integer(fields[5]);
+  m_ltzn = integer(fields[6]);
+
+  return true;
+}
+
+bool zda::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("ZDA");
+}
+
+gsv::gsv(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool gsv::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool gsv::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool gsv::update(const tokenizer& fields)
+{
+  if (!fields.is("GSV") || fields.size() < 4)
+    return false;
+
+  m_talker = fields.talker();
+  m_numMsg = integer(fields[1]);
+  m_msgNum = integer(fields[2]);
+  m_numSV = integer(fields[3]);
+
+  // Up to 4 blocks of 4 fields, followed by the signal ID from NMEA 4.10
+  m_count = std::min<size_t>((fields.size() - 4) / 4, m_satellites.size());
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    const size_t block = 4 + 4 * i;
+
+    m_satellites[i].svid = integer(fields[block]);
+    m_satellites[i].elv = integer(fields[block + 1]);
+    m_satellites[i].az = integer(fields[block + 2]);
+    m_satellites[i].cno = integer(fields[block + 3]);
+  }
+
+  m_signalId = (fields.size() - 4) % 4 == 1
+    ? integer(fields[fields.size() - 1]) : 0;
+
+  return true;
+}
+
+bool gsv::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("GSV");
+}
+
+gsa::gsa(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool gsa::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool gsa::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool gsa::update(const tokenizer& fields)
+{
+  if (!fields.is("GSA"))
+    return false;
+
+  m_talker = fields.talker();
+  m_opMode = fields[1].character();
+  m_navMode = integer(fields[2]);
+
+  m_count = 0;
+
+  for (size_t i = 0; i < m_svid.size(); ++i)
+    if (!fields[3 + i].empty())
+      m_svid[m_count++] = integer(fields[3 + i]);
+
+  for (size_t i = m_count; i < m_svid.size(); ++i)
+    m_svid[i] = 0;
+
+  m_pdop = decimal(fields[15]);
+  m_hdop = decimal(fields[16]);
+  m_vdop = decimal(fields[17]);
+  m_systemId = integer(fields[18]);
+
+  return true;
+}
+
+bool gsa::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("GSA");
+}
+
+gst::gst(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool gst::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool gst::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool gst::update(const tokenizer& fields)
+{
+  if (!fields.is("GST"))
+    return false;
+
+  m_talker = fields.talker();
+  m_time = utc_time::parse(fields[1]);
+  m_rangeRms = decimal(fields[2]);
+  m_stdMajor = decimal(fields[3]);
+  m_stdMinor = decimal(fields[4]);
+  m_orient = decimal(fields[5]);
+  m_stdLat = decimal(fields[6]);
+  m_stdLong = decimal(fields[7]);
+  m_stdAlt = decimal(fields[8]);
+
+  return true;
+}
+
+bool gst::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is("GST");
+}
+
+namespace pubx
+{
+
+position::position(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool position::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool position::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool position::update(const tokenizer& fields)
+{
+  if (!fields.is_pubx(0x00))
+    return false;
+
+  m_time = utc_time::parse(fields[2]);
+  m_lat = coordinate(fields[3], fields[4]);
+  m_lon = coordinate(fields[5], fields[6]);
+  m_altRef = decimal(fields[7]);
+
+  const token nav_stat = fields[8];
+
+  m_navStat[0] = nav_stat.size > 0 ? nav_stat.data[0] : 0x00;
+  m_navStat[1] = nav_stat.size > 1 ? nav_stat.data[1] : 0x00;
+  m_navStat[2] = 0x00;
+
+  m_hAcc = decimal(fields[9]);
+  m_vAcc = decimal(fields[10]);
+  m_sog = decimal(fields[11]);
+  m_cog = decimal(fields[12]);
+  m_vVel = decimal(fields[13]);
+  m_diffAge = decimal(fields[14]);
+  m_hdop = decimal(fields[15]);
+  m_vdop = decimal(fields[16]);
+  m_tdop = decimal(fields[17]);
+  m_numSvs = integer(fields[18]);
+  m_dr = integer(fields[20]);
+
+  return true;
+}
+
+bool position::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is_pubx(0x00);
+}
+
+svstatus::svstatus(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool svstatus::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool svstatus::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool svstatus::update(const tokenizer& fields)
+{
+  if (!fields.is_pubx(0x03))
+    return false;
+
+  // Blocks of 6 fields follow the satellite count
+  m_count = std::min<size_t>(integer(fields[2]), (fields.size() - 3) / 6);
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    const size_t block = 3 + 6 * i;
+
+    m_satellites[i].sv = integer(fields[block]);
+    m_satellites[i].s = fields[block + 1].character();
+    m_satellites[i].az = integer(fields[block + 2]);
+    m_satellites[i].el = integer(fields[block + 3]);
+    m_satellites[i].cno = integer(fields[block + 4]);
+    m_satellites[i].lck = integer(fields[block + 5]);
+  }
+
+  return true;
+}
+
+bool svstatus::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is_pubx(0x03);
+}
+
+time::time(const std::vector<uint8_t>& message)
+{
+  if (!update(message))
+    throw std::runtime_error("Message type mismatch");
+}
+
+bool time::update(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && update(fields);
+}
+
+bool time::update(const char* data, size_t size)
+{
+  tokenizer fields;
+
+  return fields.parse(data, size) && update(fields);
+}
+
+bool time::update(const tokenizer& fields)
+{
+  if (!fields.is_pubx(0x04))
+    return false;
+
+  m_time = utc_time::parse(fields[2]);
+  m_date = utc_date::parse(fields[3]);
+  m_utcTow = decimal(fields[4]);
+  m_utcWk = integer(fields[5]);
+
+  // Leap seconds carry a trailing 'D' while still the firmware default
+  token leap = fields[6];
+
+  m_leapSecDefault = leap.size > 0 && leap.data[leap.size - 1] == 'D';
+
+  if (m_leapSecDefault)
+    --leap.size;
+
+  m_leapSec = integer(leap);
+
+  m_clkBias = integer(fields[7]);
+  m_clkDrift = decimal(fields[8]);
+  m_tpGran = integer(fields[9]);
+
+  return true;
+}
+
+bool time::type(const std::vector<uint8_t>& message)
+{
+  tokenizer fields;
+
+  return fields.parse(message) && fields.is_pubx(0x04);
+}
+
+} // namespace pubx
+
+} // namespace nmea
+
+} // namespace cracl
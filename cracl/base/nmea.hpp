@@ -0,0 +1,755 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_NMEA_HPP
+#define CRACL_BASE_NMEA_HPP
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cracl
+{
+
+namespace nmea
+{
+
+/* @brief Builds an NMEA 0183 style sentence ($<address>,<field>,...*hh<CR><LF>)
+ *        in a fixed size buffer
+ *
+ * Numbers are formatted without going through the C locale or the heap, and
+ * the XOR checksum is accumulated as characters are appended so finish() only
+ * has to write the trailer. Any talker and sentence address may be used,
+ * including proprietary ones such as PUBX.
+ */
+class sentence
+{
+  // 82 characters is the longest sentence permitted by NMEA 0183
+  std::array<char, 82> m_data;
+
+  size_t m_size;
+
+  uint8_t m_checksum;
+
+  void put(char c)
+  {
+    if (m_size == m_data.size())
+      throw std::runtime_error("NMEA sentence too long");
+
+    m_data[m_size++] = c;
+
+    m_checksum ^= static_cast<uint8_t>(c);
+  }
+
+  void put_unsigned(uint64_t value);
+
+public:
+  sentence(const char* address, char start='$');
+
+  /* @brief Discard the contents and start a new sentence
+   */
+  void reset(const char* address, char start='$');
+
+  sentence& field(const char* value);
+
+  sentence& field(const std::string& value);
+
+  sentence& field(char value);
+
+  sentence& field(double value, size_t decimals=6);
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value
+    && std::is_signed<T>::value, sentence&>::type
+  field(T value)
+  {
+    put(',');
+
+    if (value < 0)
+    {
+      put('-');
+
+      // Negate in unsigned arithmetic so the most negative value is handled
+      put_unsigned(0 - static_cast<uint64_t>(value));
+    }
+    else
+      put_unsigned(value);
+
+    return *this;
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value
+    && !std::is_signed<T>::value, sentence&>::type
+  field(T value)
+  {
+    put(',');
+
+    put_unsigned(value);
+
+    return *this;
+  }
+
+  /* @brief Append a field of two upper case hexadecimal digits, as used for
+   *        PUBX message identifiers
+   */
+  sentence& hex_field(uint8_t value);
+
+  sentence& fields() { return *this; }
+
+  template <typename T, typename... Args>
+  sentence& fields(T value, Args... args)
+  {
+    field(value);
+
+    return fields(args...);
+  }
+
+  /* @brief Append the checksum and line ending, completing the sentence
+   */
+  void finish();
+
+  const char* data() const;
+
+  size_t size() const;
+
+  uint8_t checksum() const;
+
+}; // nmea::sentence
+
+/* @brief One field of a received sentence, pointing into the sentence itself
+ */
+struct token
+{
+  const char* data;
+  size_t size;
+
+  bool empty() const { return size == 0; }
+
+  bool operator==(const char* value) const;
+
+  bool operator!=(const char* value) const { return !(*this == value); }
+
+  /* @brief First character, or 0x00 for an empty field
+   */
+  char character() const { return size == 0 ? 0x00 : data[0]; }
+};
+
+/* @brief Locale independent number parsing for NMEA fields (digits with an
+ *        optional sign and decimal point)
+ *
+ * @return False if the field is empty or not a number, leaving value as is
+ */
+bool number(const token& field, double& value);
+
+bool number(const token& field, int64_t& value);
+
+bool number(const token& field, uint64_t& value);
+
+/* @brief Field as a double, NaN if empty or invalid
+ */
+double decimal(const token& field);
+
+/* @brief Field as an integer, fallback if empty or invalid
+ */
+int64_t integer(const token& field, int64_t fallback=0);
+
+/* @brief Latitude/longitude in degrees from a (d)ddmm.mmmm field and its
+ *        N/S/E/W indicator, NaN if empty
+ */
+double coordinate(const token& value, const token& direction);
+
+struct utc_time
+{
+  bool valid;
+
+  uint8_t hour;
+  uint8_t minute;
+  double second;
+
+  /* @brief Parse an hhmmss.ss field
+   */
+  static utc_time parse(const token& field);
+};
+
+struct utc_date
+{
+  bool valid;
+
+  uint8_t day;
+  uint8_t month;
+  uint16_t year;
+
+  /* @brief Parse a ddmmyy field (years 2000-2099)
+   */
+  static utc_date parse(const token& field);
+};
+
+/* @brief Validates a received sentence and splits it into fields in place
+ *
+ * The sentence is not copied, so it must outlive the tokenizer. Field 0 is
+ * the address (e.g. GPGGA or PUBX). The trailing checksum and any line ending
+ * are not part of the fields.
+ */
+class tokenizer
+{
+public:
+  // PUBX,03 carries 6 fields per satellite, so it is well over NMEA's limit.
+  //   Sized for every channel of a 72 channel multi-GNSS receiver
+  static constexpr size_t max_fields = 3 + 6 * 72;
+
+  // Longest sentence accepted ($...*hh), enough for PUBX,03 with 72
+  //   satellites of at most 21 characters each (1526)
+  static constexpr size_t max_length = 1536;
+
+private:
+  const char* m_data;
+
+  size_t m_count;
+
+  // Start of each field, plus one past the end of the last
+  std::array<uint16_t, max_fields + 1> m_start;
+
+public:
+  tokenizer();
+
+  /* @brief Split a sentence ($...*hh, optionally followed by <CR><LF>)
+   *
+   * @return False if the framing or checksum is invalid
+   */
+  bool parse(const char* data, size_t size);
+
+  bool parse(const std::vector<uint8_t>& message);
+
+  size_t size() const;
+
+  /* @brief Field i, or an empty field past the end of the sentence
+   */
+  token operator[](size_t i) const;
+
+  /* @brief True for a standard sentence with the given formatter (e.g. "GGA")
+   *        from any talker
+   */
+  bool is(const char* formatter) const;
+
+  /* @brief True for the PUBX sentence with the given message ID
+   */
+  bool is_pubx(uint8_t msg_id) const;
+
+  /* @brief Two character talker ID of a standard sentence (e.g. "GN")
+   */
+  std::array<char, 3> talker() const;
+
+}; // nmea::tokenizer
+
+/* @brief Global positioning system fix data
+ */
+class gga
+{
+  std::array<char, 3> m_talker;
+
+  utc_time m_time;
+
+  double m_lat;
+  double m_lon;
+
+  uint8_t m_quality;
+  uint8_t m_numSV;
+
+  double m_hdop;
+  double m_alt;
+  double m_sep;
+  double m_diffAge;
+
+  uint16_t m_diffStation;
+
+public:
+  gga(){ }
+
+  gga(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  utc_time time() const { return m_time; }
+
+  double lat() const { return m_lat; }
+
+  double lon() const { return m_lon; }
+
+  uint8_t quality() const { return m_quality; }
+
+  uint8_t numSV() const { return m_numSV; }
+
+  double hdop() const { return m_hdop; }
+
+  double alt() const { return m_alt; }
+
+  double sep() const { return m_sep; }
+
+  double diffAge() const { return m_diffAge; }
+
+  uint16_t diffStation() const { return m_diffStation; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::gga
+
+/* @brief Recommended minimum data
+ */
+class rmc
+{
+  std::array<char, 3> m_talker;
+
+  utc_time m_time;
+  utc_date m_date;
+
+  char m_status;
+
+  double m_lat;
+  double m_lon;
+  double m_spd;
+  double m_cog;
+  double m_mv;
+
+  char m_posMode;
+  char m_navStatus;
+
+public:
+  rmc(){ }
+
+  rmc(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  utc_time time() const { return m_time; }
+
+  utc_date date() const { return m_date; }
+
+  char status() const { return m_status; }
+
+  double lat() const { return m_lat; }
+
+  double lon() const { return m_lon; }
+
+  double spd() const { return m_spd; }
+
+  double cog() const { return m_cog; }
+
+  double mv() const { return m_mv; }
+
+  char posMode() const { return m_posMode; }
+
+  char navStatus() const { return m_navStatus; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::rmc
+
+/* @brief Time and date
+ */
+class zda
+{
+  std::array<char, 3> m_talker;
+
+  utc_time m_time;
+  utc_date m_date;
+
+  int8_t m_ltzh;
+  uint8_t m_ltzn;
+
+public:
+  zda(){ }
+
+  zda(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  utc_time time() const { return m_time; }
+
+  utc_date date() const { return m_date; }
+
+  int8_t ltzh() const { return m_ltzh; }
+
+  uint8_t ltzn() const { return m_ltzn; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::zda
+
+/* @brief Satellites in view (one sentence of a group)
+ */
+class gsv
+{
+public:
+  struct satellite
+  {
+    uint16_t svid;
+    int8_t elv;
+    uint16_t az;
+    uint8_t cno;
+  };
+
+private:
+  std::array<char, 3> m_talker;
+
+  uint8_t m_numMsg;
+  uint8_t m_msgNum;
+  uint8_t m_numSV;
+
+  size_t m_count;
+  std::array<satellite, 4> m_satellites;
+
+  uint8_t m_signalId;
+
+public:
+  gsv(){ }
+
+  gsv(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  uint8_t numMsg() const { return m_numMsg; }
+
+  uint8_t msgNum() const { return m_msgNum; }
+
+  uint8_t numSV() const { return m_numSV; }
+
+  /* @brief Number of satellites carried by this sentence
+   */
+  size_t count() const { return m_count; }
+
+  const satellite& sat(size_t i) const { return m_satellites.at(i); }
+
+  /* @brief Signal ID (NMEA 4.10 and later, otherwise 0)
+   */
+  uint8_t signalId() const { return m_signalId; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::gsv
+
+/* @brief DOP and active satellites
+ */
+class gsa
+{
+  std::array<char, 3> m_talker;
+
+  char m_opMode;
+  uint8_t m_navMode;
+
+  size_t m_count;
+  std::array<uint16_t, 12> m_svid;
+
+  double m_pdop;
+  double m_hdop;
+  double m_vdop;
+
+  uint8_t m_systemId;
+
+public:
+  gsa(){ }
+
+  gsa(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  char opMode() const { return m_opMode; }
+
+  uint8_t navMode() const { return m_navMode; }
+
+  /* @brief Number of satellites used (non-empty svid fields)
+   */
+  size_t count() const { return m_count; }
+
+  uint16_t svid(size_t i) const { return m_svid.at(i); }
+
+  double pdop() const { return m_pdop; }
+
+  double hdop() const { return m_hdop; }
+
+  double vdop() const { return m_vdop; }
+
+  /* @brief GNSS system ID (NMEA 4.10 and later, otherwise 0)
+   */
+  uint8_t systemId() const { return m_systemId; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::gsa
+
+/* @brief Pseudorange error statistics
+ */
+class gst
+{
+  std::array<char, 3> m_talker;
+
+  utc_time m_time;
+
+  double m_rangeRms;
+  double m_stdMajor;
+  double m_stdMinor;
+  double m_orient;
+  double m_stdLat;
+  double m_stdLong;
+  double m_stdAlt;
+
+public:
+  gst(){ }
+
+  gst(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  std::array<char, 3> talker() const { return m_talker; }
+
+  utc_time time() const { return m_time; }
+
+  double rangeRms() const { return m_rangeRms; }
+
+  double stdMajor() const { return m_stdMajor; }
+
+  double stdMinor() const { return m_stdMinor; }
+
+  double orient() const { return m_orient; }
+
+  double stdLat() const { return m_stdLat; }
+
+  double stdLong() const { return m_stdLong; }
+
+  double stdAlt() const { return m_stdAlt; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::gst
+
+namespace pubx
+{
+
+/* @brief PUBX,00 lat/long position data
+ */
+class position
+{
+  utc_time m_time;
+
+  double m_lat;
+  double m_lon;
+  double m_altRef;
+
+  std::array<char, 3> m_navStat;
+
+  double m_hAcc;
+  double m_vAcc;
+  double m_sog;
+  double m_cog;
+  double m_vVel;
+  double m_diffAge;
+  double m_hdop;
+  double m_vdop;
+  double m_tdop;
+
+  uint8_t m_numSvs;
+  uint8_t m_dr;
+
+public:
+  position(){ }
+
+  position(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  utc_time time() const { return m_time; }
+
+  double lat() const { return m_lat; }
+
+  double lon() const { return m_lon; }
+
+  double altRef() const { return m_altRef; }
+
+  /* @brief Navigation status (e.g. "NF", "G3", "D3")
+   */
+  std::array<char, 3> navStat() const { return m_navStat; }
+
+  double hAcc() const { return m_hAcc; }
+
+  double vAcc() const { return m_vAcc; }
+
+  double sog() const { return m_sog; }
+
+  double cog() const { return m_cog; }
+
+  double vVel() const { return m_vVel; }
+
+  double diffAge() const { return m_diffAge; }
+
+  double hdop() const { return m_hdop; }
+
+  double vdop() const { return m_vdop; }
+
+  double tdop() const { return m_tdop; }
+
+  uint8_t numSvs() const { return m_numSvs; }
+
+  uint8_t dr() const { return m_dr; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::pubx::position
+
+/* @brief PUBX,03 satellite status
+ */
+class svstatus
+{
+public:
+  struct satellite
+  {
+    uint16_t sv;
+    char s;
+    uint16_t az;
+    int8_t el;
+    uint8_t cno;
+    uint8_t lck;
+  };
+
+  static constexpr size_t max_satellites = (tokenizer::max_fields - 3) / 6;
+
+private:
+  size_t m_count;
+  std::array<satellite, max_satellites> m_satellites;
+
+public:
+  svstatus(){ }
+
+  svstatus(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  size_t n() const { return m_count; }
+
+  const satellite& sat(size_t i) const { return m_satellites.at(i); }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::pubx::svstatus
+
+/* @brief PUBX,04 time of day and clock information
+ */
+class time
+{
+  utc_time m_time;
+  utc_date m_date;
+
+  double m_utcTow;
+  uint16_t m_utcWk;
+
+  int8_t m_leapSec;
+  bool m_leapSecDefault;
+
+  int64_t m_clkBias;
+  double m_clkDrift;
+  uint32_t m_tpGran;
+
+public:
+  time(){ }
+
+  time(const std::vector<uint8_t>& message);
+
+  bool update(const std::vector<uint8_t>& message);
+
+  bool update(const char* data, size_t size);
+
+  bool update(const tokenizer& fields);
+
+  utc_time utc() const { return m_time; }
+
+  utc_date date() const { return m_date; }
+
+  double utcTow() const { return m_utcTow; }
+
+  uint16_t utcWk() const { return m_utcWk; }
+
+  int8_t leapSec() const { return m_leapSec; }
+
+  /* @brief True if the leap second count is the firmware default rather
+   *        than one received from the satellites
+   */
+  bool leapSecDefault() const { return m_leapSecDefault; }
+
+  int64_t clkBias() const { return m_clkBias; }
+
+  double clkDrift() const { return m_clkDrift; }
+
+  uint32_t tpGran() const { return m_tpGran; }
+
+  static bool type(const std::vector<uint8_t>& message);
+
+}; // nmea::pubx::time
+
+} // namespace pubx
+
+} // namespace nmea
+
+} // namespace cracl
+
+#endif // CRACL_BASE_NMEA_HPP
@@ -0,0 +1,159 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "ntp.hpp"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+
+namespace cracl
+{
+
+namespace ntp
+{
+
+namespace
+{
+
+const int key_base = 0x4e545030; // "NTP0"
+
+/* @brief Split a time into whole seconds and nanoseconds (0 to 999999999)
+ */
+void split(clock::time_point t, time_t& sec, unsigned& nsec)
+{
+  const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      t.time_since_epoch()).count();
+
+  int64_t s = ns / 1000000000;
+  int64_t rem = ns % 1000000000;
+
+  if (rem < 0)
+  {
+    --s;
+    rem += 1000000000;
+  }
+
+  sec = static_cast<time_t>(s);
+  nsec = static_cast<unsigned>(rem);
+}
+
+} // namespace
+
+shm_refclock::shm_refclock(int unit, int precision)
+  : m_unit (unit), m_precision (precision), m_leap (no_warning),
+  m_samples (0)
+{
+  const int id = shmget(key(unit), sizeof (shm_time),
+      IPC_CREAT | (unit < 2 ? 0600 : 0666));
+
+  if (id < 0)
+    throw std::runtime_error("Could not get NTP SHM segment for unit "
+        + std::to_string(unit) + ": " + std::strerror(errno));
+
+  void* segment = shmat(id, nullptr, 0);
+
+  if (segment == reinterpret_cast<void*>(-1))
+    throw std::runtime_error("Could not attach NTP SHM segment for unit "
+        + std::to_string(unit) + ": " + std::strerror(errno));
+
+  m_segment = static_cast<shm_time*>(segment);
+
+  m_segment->valid = 0;
+  m_segment->mode = 1;
+  m_segment->nsamples = 3;
+}
+
+shm_refclock::~shm_refclock()
+{
+  m_segment->valid = 0;
+
+  shmdt(m_segment);
+}
+
+int shm_refclock::key(int unit)
+{
+  return key_base + unit;
+}
+
+int shm_refclock::unit() const
+{
+  return m_unit;
+}
+
+void shm_refclock::leap(leap_indicator leap)
+{
+  m_leap = leap;
+}
+
+leap_indicator shm_refclock::leap() const
+{
+  return m_leap;
+}
+
+void shm_refclock::sample(clock::time_point clock_time,
+    clock::time_point receive_time)
+{
+  time_t clock_sec, receive_sec;
+  unsigned clock_nsec, receive_nsec;
+
+  split(clock_time, clock_sec, clock_nsec);
+  split(receive_time, receive_sec, receive_nsec);
+
+  m_segment->valid = 0;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  m_segment->count = m_segment->count + 1;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  m_segment->clockTimeStampSec = clock_sec;
+  m_segment->clockTimeStampUSec = static_cast<int>(clock_nsec / 1000);
+  m_segment->clockTimeStampNSec = clock_nsec;
+  m_segment->receiveTimeStampSec = receive_sec;
+  m_segment->receiveTimeStampUSec = static_cast<int>(receive_nsec / 1000);
+  m_segment->receiveTimeStampNSec = receive_nsec;
+  m_segment->leap = m_leap;
+  m_segment->precision = m_precision;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  m_segment->count = m_segment->count + 1;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  m_segment->valid = 1;
+
+  ++m_samples;
+}
+
+uint64_t shm_refclock::samples() const
+{
+  return m_samples;
+}
+
+} // namespace ntp
+
+} // namespace cracl
@@ -0,0 +1,120 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_NTP_HPP
+#define CRACL_BASE_NTP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+namespace cracl
+{
+
+namespace ntp
+{
+
+typedef std::chrono::system_clock clock;
+
+/* @brief Layout of the shared memory segment read by the SHM refclock driver
+ *        of ntpd and chrony (and written by gpsd)
+ */
+struct shm_time
+{
+  int mode;
+  volatile int count;
+  time_t clockTimeStampSec;
+  int clockTimeStampUSec;
+  time_t receiveTimeStampSec;
+  int receiveTimeStampUSec;
+  int leap;
+  int precision;
+  int nsamples;
+  volatile int valid;
+  unsigned clockTimeStampNSec;
+  unsigned receiveTimeStampNSec;
+  int dummy[8];
+};
+
+enum leap_indicator
+{
+  no_warning = 0,
+  insert_second = 1,
+  delete_second = 2,
+  not_synchronized = 3
+};
+
+/* @brief Feeds time samples to ntpd or chrony through an SHM refclock
+ *        segment (e.g. "refclock SHM 0" in chrony.conf)
+ *
+ * Samples are written with the count/valid protocol (mode 1): valid is
+ * cleared and count bumped before the fields are written, and count bumped
+ * and valid set after, so the daemon discards a sample it read mid-update.
+ * Writing is a handful of stores and never blocks.
+ */
+class shm_refclock
+{
+  shm_time* m_segment;
+
+  int m_unit;
+  int m_precision;
+  leap_indicator m_leap;
+  uint64_t m_samples;
+
+public:
+  /* @param unit Refclock unit, the segment key is 0x4e545030 + unit. Units 0
+   *        and 1 are only accessible to root, as ntpd expects
+   * @param precision Sample precision as a power of 2 in seconds (e.g. -7
+   *        for about 8 ms)
+   */
+  shm_refclock(int unit=0, int precision=-7);
+
+  ~shm_refclock();
+
+  shm_refclock(const shm_refclock&) = delete;
+
+  shm_refclock& operator=(const shm_refclock&) = delete;
+
+  static int key(int unit);
+
+  int unit() const;
+
+  /* @brief Leap second warning sent with following samples
+   */
+  void leap(leap_indicator leap);
+
+  leap_indicator leap() const;
+
+  /* @brief Publish a sample
+   *
+   * @param clock_time True (reference) time of an event
+   * @param receive_time Host system clock time of the same event
+   */
+  void sample(clock::time_point clock_time, clock::time_point receive_time);
+
+  uint64_t samples() const;
+
+};
+
+} // namespace ntp
+
+} // namespace cracl
+
+#endif // CRACL_BASE_NTP_HPP
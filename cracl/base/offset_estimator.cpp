@@ -0,0 +1,169 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "offset_estimator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace cracl
+{
+
+namespace
+{
+
+// Effective samples needed before the fit is reported or used to reject
+const double min_samples = 8;
+
+double seconds(std::chrono::system_clock::duration d)
+{
+  return std::chrono::duration<double>(d).count();
+}
+
+} // namespace
+
+offset_estimator::offset_estimator(double time_constant, double rejection,
+    size_t max_rejected)
+  : m_lambda (1 - 1 / std::max(time_constant, 1.0)), m_rejection (rejection),
+  m_max_rejected (max_rejected), m_rejected (0), m_restarts (0)
+{
+  reset();
+}
+
+bool offset_estimator::add(clock::time_point reference,
+    clock::time_point arrival)
+{
+  const double y = seconds(arrival - reference);
+
+  if (m_started)
+  {
+    // Move the origin to the new sample, keeping x small so the sums don't
+    //   lose precision as time goes on
+    const double d = seconds(reference - m_last);
+
+    m_xx += d * (d * m_w - 2 * m_x);
+    m_xy -= d * m_y;
+    m_x -= d * m_w;
+
+    const estimate e = current();
+
+    if (e.valid)
+    {
+      const double residual = y - e.offset;
+      const double bound = m_rejection * std::sqrt(e.jitter * e.jitter
+          + e.uncertainty * e.uncertainty / 4);
+
+      if (residual > bound)
+      {
+        ++m_rejected;
+
+        if (++m_consecutive >= m_max_rejected)
+        {
+          ++m_restarts;
+
+          reset();
+        }
+        else
+        {
+          // Keep the origin at the latest sample even though it's unused
+          m_last = reference;
+
+          return false;
+        }
+      }
+      else
+        m_consecutive = 0;
+    }
+  }
+
+  m_w = m_lambda * m_w + 1;
+  m_w2 = m_lambda * m_lambda * m_w2 + 1;
+  m_x = m_lambda * m_x;
+  m_y = m_lambda * m_y + y;
+  m_xx = m_lambda * m_xx;
+  m_xy = m_lambda * m_xy;
+  m_yy = m_lambda * m_yy + y * y;
+
+  m_last = reference;
+  m_started = true;
+
+  return true;
+}
+
+offset_estimator::estimate offset_estimator::current() const
+{
+  estimate e = { 0, 0, 0, 0, 0, false };
+
+  if (m_w <= 0)
+    return e;
+
+  const double mean_x = m_x / m_w;
+  const double mean_y = m_y / m_w;
+  const double var_x = m_xx / m_w - mean_x * mean_x;
+  const double var_y = m_yy / m_w - mean_y * mean_y;
+  const double cov = m_xy / m_w - mean_x * mean_y;
+
+  e.drift = var_x > 1e-12 ? cov / var_x : 0;
+
+  // Fit evaluated at the latest sample, where x is 0
+  e.offset = mean_y - e.drift * mean_x;
+  e.samples = m_w * m_w / m_w2;
+
+  const double residual = std::max(0.0, var_y - e.drift * cov);
+
+  e.jitter = std::sqrt(residual);
+
+  if (e.samples > 2)
+  {
+    // Residual variance corrected for the two fitted parameters, and the
+    //   standard error of the line at x = 0
+    const double s2 = residual * e.samples / (e.samples - 2);
+    const double se2 = s2 / e.samples * (1 + (var_x > 1e-12
+          ? mean_x * mean_x / var_x : 0));
+
+    e.uncertainty = 2 * std::sqrt(se2);
+  }
+
+  e.valid = e.samples >= min_samples;
+
+  return e;
+}
+
+size_t offset_estimator::rejected() const
+{
+  return m_rejected;
+}
+
+size_t offset_estimator::restarts() const
+{
+  return m_restarts;
+}
+
+void offset_estimator::reset()
+{
+  m_w = m_w2 = m_x = m_y = m_xx = m_xy = m_yy = 0;
+
+  m_started = false;
+  m_consecutive = 0;
+}
+
+} // namespace cracl
@@ -0,0 +1,129 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_OFFSET_ESTIMATOR_HPP
+#define CRACL_BASE_OFFSET_ESTIMATOR_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace cracl
+{
+
+/* @brief Tracks the offset and drift of the host clock against a reference
+ *        time from noisy event timestamps (e.g. the arrival of the first
+ *        message of each navigation epoch)
+ *
+ * A line is fitted to (arrival - reference) against reference time with
+ * exponentially weighted sums, so each sample costs a constant handful of
+ * operations. Timestamps can only be late (USB polling, scheduling), so once
+ * the fit has settled, samples later than the prediction by more than a
+ * number of standard deviations are rejected while early ones are always
+ * kept. A run of consecutive rejections means the host clock was stepped, and
+ * restarts the fit.
+ *
+ * The offset includes the fixed part of the delay between the event and its
+ * timestamp (e.g. the time to send the preceding messages), which has to be
+ * calibrated separately.
+ */
+class offset_estimator
+{
+public:
+  typedef std::chrono::system_clock clock;
+
+  struct estimate
+  {
+    // Host clock minus reference time at the latest sample, in seconds
+    double offset;
+
+    // Rate the offset changes at, in seconds per second (positive when the
+    //   host clock runs fast)
+    double drift;
+
+    // 95 % confidence bound on the offset, in seconds
+    double uncertainty;
+
+    // Standard deviation of accepted samples about the fit, in seconds
+    double jitter;
+
+    // Effective number of samples in the fit
+    double samples;
+
+    // False until enough samples have been accepted
+    bool valid;
+  };
+
+private:
+  double m_lambda;
+  double m_rejection;
+  size_t m_max_rejected;
+
+  // Weighted sums of x (reference time relative to the latest sample), y
+  //   (offset) and their products, plus the sum of squared weights
+  double m_w;
+  double m_w2;
+  double m_x;
+  double m_y;
+  double m_xx;
+  double m_xy;
+  double m_yy;
+
+  clock::time_point m_last;
+  bool m_started;
+
+  size_t m_consecutive;
+  size_t m_rejected;
+  size_t m_restarts;
+
+public:
+  /* @param time_constant Samples over which older samples are forgotten
+   * @param rejection Standard deviations late a sample may be before it is
+   *        rejected
+   * @param max_rejected Consecutive rejections after which the fit restarts
+   */
+  offset_estimator(double time_constant=64, double rejection=3,
+      size_t max_rejected=8);
+
+  /* @brief Add a sample
+   *
+   * @param reference True time of an event
+   * @param arrival Host clock time the event was timestamped at
+   *
+   * @return False if the sample was rejected as late
+   */
+  bool add(clock::time_point reference, clock::time_point arrival);
+
+  estimate current() const;
+
+  /* @brief Samples rejected as late so far
+   */
+  size_t rejected() const;
+
+  /* @brief Times the fit restarted after a run of rejections
+   */
+  size_t restarts() const;
+
+  void reset();
+
+};
+
+} // namespace cracl
+
+#endif // CRACL_BASE_OFFSET_ESTIMATOR_HPP
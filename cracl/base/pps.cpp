@@ -0,0 +1,289 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "pps.hpp"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace cracl
+{
+
+namespace pps
+{
+
+namespace
+{
+
+// Edges kept for pairing, a few seconds worth
+const size_t max_edges = 16;
+
+void ignore_signal(int)
+{ }
+
+/* @brief Make sure the signal used to interrupt TIOCMIWAIT doesn't terminate
+ *        the process, without replacing a handler the application set
+ */
+void install_interrupt_handler()
+{
+  static std::once_flag once;
+
+  std::call_once(once, []()
+      {
+        struct sigaction current;
+
+        if (sigaction(SIGRTMIN, nullptr, &current) == 0
+            && current.sa_handler == SIG_DFL)
+        {
+          struct sigaction action;
+
+          std::memset(&action, 0, sizeof (action));
+          sigemptyset(&action.sa_mask);
+
+          // No SA_RESTART, the ioctl has to fail with EINTR
+          action.sa_handler = ignore_signal;
+
+          sigaction(SIGRTMIN, &action, nullptr);
+        }
+      });
+}
+
+} // namespace
+
+edge_source::~edge_source()
+{ }
+
+modem_line_source::modem_line_source(const std::string& location, int lines)
+  : m_lines (lines == 0 ? TIOCM_CD : lines), m_stopped (false),
+  m_waiting (false), m_thread ()
+{
+  m_fd = open(location.c_str(), O_RDONLY | O_NOCTTY | O_NONBLOCK);
+
+  if (m_fd < 0)
+    throw std::runtime_error("Could not open " + location
+        + " for PPS: " + std::strerror(errno));
+
+  install_interrupt_handler();
+}
+
+modem_line_source::~modem_line_source()
+{
+  stop();
+
+  close(m_fd);
+}
+
+bool modem_line_source::wait(bool& level)
+{
+#ifdef TIOCMIWAIT
+  m_thread = pthread_self();
+  m_waiting = true;
+
+  while (!m_stopped)
+  {
+    if (ioctl(m_fd, TIOCMIWAIT, m_lines) != 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      break;                    // Not a serial port with modem lines
+    }
+
+    int status;
+
+    if (ioctl(m_fd, TIOCMGET, &status) != 0)
+      break;
+
+    level = (status & m_lines) != 0;
+
+    m_waiting = false;
+
+    return true;
+  }
+
+  m_waiting = false;
+#else
+  (void) level;
+#endif
+
+  return false;
+}
+
+void modem_line_source::stop()
+{
+  m_stopped = true;
+
+  // The signal may arrive just before the ioctl starts, so keep sending it
+  //   until the waiting thread is out
+  while (m_waiting)
+  {
+    pthread_kill(m_thread, SIGRTMIN);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+void modem_line_source::start()
+{
+  m_stopped = false;
+}
+
+injected_source::injected_source()
+  : m_stopped (false)
+{ }
+
+void injected_source::inject(bool level)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_levels.push_back(level);
+
+  m_changed.notify_all();
+}
+
+bool injected_source::wait(bool& level)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_changed.wait(lock, [this]() { return m_stopped || !m_levels.empty(); });
+
+  if (m_stopped)
+    return false;
+
+  level = m_levels.front();
+
+  m_levels.pop_front();
+
+  return true;
+}
+
+void injected_source::stop()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_stopped = true;
+
+  m_changed.notify_all();
+}
+
+void injected_source::start()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_stopped = false;
+}
+
+monitor::monitor(edge_source& source, bool assert_high)
+  : m_source (source), m_assert_high (assert_high), m_count (0)
+{
+  // The source may have been stopped by an earlier monitor
+  m_source.start();
+
+  m_thread = std::thread([this]() { run(); });
+}
+
+monitor::~monitor()
+{
+  m_source.stop();
+
+  m_thread.join();
+}
+
+void monitor::run()
+{
+  bool level;
+
+  while (m_source.wait(level))
+  {
+    edge e;
+
+    // Timestamp before anything else
+    e.real = realtime::now();
+    e.mono = monotonic::now();
+    e.assert = level == m_assert_high;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    e.sequence = ++m_count;
+
+    m_edges.push_back(e);
+
+    if (m_edges.size() > max_edges)
+      m_edges.pop_front();
+  }
+}
+
+bool monitor::assert_before(realtime::time_point t, edge& result,
+    std::chrono::milliseconds max_age)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (auto it = m_edges.rbegin(); it != m_edges.rend(); ++it)
+  {
+    if (it->real > t || !it->assert)
+      continue;
+
+    if (t - it->real > max_age)
+      break;
+
+    result = *it;
+
+    return true;
+  }
+
+  return false;
+}
+
+bool monitor::latest(edge& result)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_edges.empty())
+    return false;
+
+  result = m_edges.back();
+
+  return true;
+}
+
+uint64_t monitor::edges()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_count;
+}
+
+} // namespace pps
+
+} // namespace cracl
@@ -0,0 +1,207 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_PPS_HPP
+#define CRACL_BASE_PPS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cracl
+{
+
+namespace pps
+{
+
+typedef std::chrono::system_clock realtime;   // CLOCK_REALTIME
+typedef std::chrono::steady_clock monotonic;  // CLOCK_MONOTONIC
+
+/* @brief Change of the PPS line, timestamped as soon as it was seen
+ */
+struct edge
+{
+  realtime::time_point real;
+  monotonic::time_point mono;
+
+  // True for the leading (assert) edge of a pulse
+  bool assert;
+
+  // Count of edges seen by the monitor, starting at 1
+  uint64_t sequence;
+};
+
+/* @brief Something that blocks until the PPS line changes
+ */
+class edge_source
+{
+public:
+  virtual ~edge_source();
+
+  /* @brief Block until the line changes
+   *
+   * @param level Set to the new level of the line
+   *
+   * @return False once stopped, or if the line can't be monitored
+   */
+  virtual bool wait(bool& level) = 0;
+
+  /* @brief Make a blocked wait() return false, from any thread. Later
+   *        waits also return false until start() is called
+   */
+  virtual void stop() = 0;
+
+  /* @brief Undo stop(), so that wait() blocks for changes again. Not to be
+   *        called while another thread is waiting
+   */
+  virtual void start() = 0;
+
+};
+
+/* @brief Waits for changes of serial modem control lines with TIOCMIWAIT
+ *        (Linux only)
+ *
+ * The port is opened a second time just for the ioctls, which leaves the
+ * settings of the port and anybody reading it alone. TIOCMIWAIT can't time
+ * out, so stop() interrupts it with a signal (SIGRTMIN, given a handler that
+ * does nothing if it has none).
+ */
+class modem_line_source : public edge_source
+{
+  int m_fd;
+  int m_lines;
+
+  std::atomic<bool> m_stopped;
+  std::atomic<bool> m_waiting;
+  std::thread::native_handle_type m_thread;
+
+public:
+  /* @param location Path of the serial port (e.g. "/dev/ttyUSB0")
+   * @param lines Modem lines carrying PPS, e.g. TIOCM_CTS from
+   *        <sys/ioctl.h>, 0 for DCD
+   */
+  modem_line_source(const std::string& location, int lines=0);
+
+  ~modem_line_source();
+
+  bool wait(bool& level) override;
+
+  void stop() override;
+
+  void start() override;
+
+};
+
+/* @brief Edges supplied by the caller, e.g. to exercise PPS handling on a pty
+ *        or from recorded data
+ */
+class injected_source : public edge_source
+{
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  std::deque<bool> m_levels;
+  bool m_stopped;
+
+public:
+  injected_source();
+
+  /* @brief Queue a change of the line to a level
+   */
+  void inject(bool level);
+
+  bool wait(bool& level) override;
+
+  void stop() override;
+
+  void start() override;
+
+};
+
+/* @brief Timestamps edges from a source on a background thread, keeping the
+ *        most recent ones for pairing with the messages that label them
+ *
+ * The source is started when the monitor is created and stopped when it is
+ * destroyed, so a source can be monitored again once an earlier monitor of
+ * it is gone.
+ */
+class monitor
+{
+  edge_source& m_source;
+  bool m_assert_high;
+
+  std::mutex m_mutex;
+  std::deque<edge> m_edges;
+  uint64_t m_count;
+
+  std::thread m_thread;
+
+  void run();
+
+public:
+  /* @param assert_high True if a pulse starts when the line goes high
+   */
+  monitor(edge_source& source, bool assert_high=true);
+
+  ~monitor();
+
+  monitor(const monitor&) = delete;
+
+  monitor& operator=(const monitor&) = delete;
+
+  /* @brief Most recent assert edge no later than a time (and no more than
+   *        max_age before it)
+   *
+   * @return False if there is none
+   */
+  bool assert_before(realtime::time_point t, edge& result,
+      std::chrono::milliseconds max_age=std::chrono::milliseconds(1000));
+
+  /* @brief Most recent edge of either kind
+   *
+   * @return False if none has been seen
+   */
+  bool latest(edge& result);
+
+  /* @brief Edges seen so far
+   */
+  uint64_t edges();
+
+};
+
+/* @brief An assert edge paired with the time it marks
+ */
+struct sample
+{
+  edge pulse;
+
+  // Time the pulse marks according to the receiver
+  realtime::time_point reference;
+};
+
+} // namespace pps
+
+} // namespace cracl
+
+#endif // CRACL_BASE_PPS_HPP
@@ -0,0 +1,269 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "server.hpp"
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cracl
+{
+
+namespace
+{
+
+size_t ring_size(size_t max_lag)
+{
+  // Power of two at least four times the lag, so a client is disconnected
+  //   long before the data queued for it is overwritten
+  size_t size = 4096;
+
+  while (size < 4 * max_lag)
+    size *= 2;
+
+  return size;
+}
+
+} // namespace
+
+stream_server::client::client(boost::asio::io_service& io)
+  : socket (io), offset (0), writing (false), lagging (false)
+{ }
+
+stream_server::stream_server(unsigned short port, const std::string& address,
+    size_t max_lag)
+  : m_work (new boost::asio::io_service::work(m_io)),
+  m_acceptor (m_io, boost::asio::ip::tcp::endpoint(
+        boost::asio::ip::address::from_string(address), port)),
+  m_ring (ring_size(max_lag)), m_max_lag (max_lag), m_head (0),
+  m_dropped (0)
+{
+  accept();
+
+  m_thread = std::thread([this]() { m_io.run(); });
+}
+
+stream_server::~stream_server()
+{
+  m_work.reset();
+  m_io.stop();
+
+  m_thread.join();
+}
+
+void stream_server::accept()
+{
+  auto c = std::make_shared<client>(m_io);
+
+  m_acceptor.async_accept(c->socket,
+      [this, c](const boost::system::error_code& error)
+      {
+        if (error == boost::asio::error::operation_aborted)
+          return;
+
+        if (!error)
+        {
+          boost::system::error_code ignored;
+
+          c->socket.set_option(boost::asio::ip::tcp::no_delay(true),
+              ignored);
+
+          std::lock_guard<std::mutex> lock(m_mutex);
+
+          c->offset = m_head;
+
+          m_clients.push_back(c);
+        }
+
+        accept();
+      });
+}
+
+void stream_server::publish(const uint8_t* data, size_t size)
+{
+  std::vector<std::shared_ptr<client>> idle;
+  std::vector<std::shared_ptr<client>> lagging;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_clients.empty())
+    {
+      m_head += size;
+
+      return;
+    }
+
+    const size_t mask = m_ring.size() - 1;
+
+    // Data larger than the ring only needs its tail kept, every client will
+    //   be too far behind to want the rest
+    if (size > m_ring.size())
+    {
+      m_head += size - m_ring.size();
+      data += size - m_ring.size();
+      size = m_ring.size();
+    }
+
+    // Clients this data puts too far behind are picked out before it is
+    //   copied, so the ring only ever overwrites bytes still unsent to
+    //   clients that are being dropped
+    for (const auto& c : m_clients)
+    {
+      if (!c->lagging && m_head + size - c->offset > m_max_lag)
+      {
+        c->lagging = true;
+
+        lagging.push_back(c);
+      }
+      else if (!c->writing)
+      {
+        c->writing = true;
+
+        idle.push_back(c);
+      }
+    }
+
+    const size_t start = m_head & mask;
+    const size_t first = std::min(size, m_ring.size() - start);
+
+    std::memcpy(m_ring.data() + start, data, first);
+    std::memcpy(m_ring.data(), data + first, size - first);
+
+    m_head += size;
+  }
+
+  for (auto& c : idle)
+    m_io.post([this, c]() { send(c); });
+
+  // A lagging client usually has a write stuck waiting for it, closing the
+  //   socket aborts the write
+  for (auto& c : lagging)
+    m_io.post([this, c]()
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+
+          if (c->socket.is_open())
+          {
+            ++m_dropped;
+
+            remove(c);
+          }
+        });
+}
+
+void stream_server::send(std::shared_ptr<client> c)
+{
+  std::array<boost::asio::const_buffer, 2> buffers;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Already removed, e.g. a send posted before the client was dropped
+    if (!c->socket.is_open())
+      return;
+
+    if (c->lagging || m_head - c->offset > m_max_lag)
+    {
+      ++m_dropped;
+
+      remove(c);
+
+      return;
+    }
+
+    const size_t mask = m_ring.size() - 1;
+    const size_t pending = m_head - c->offset;
+
+    if (pending == 0)
+    {
+      c->writing = false;
+
+      return;
+    }
+
+    const size_t start = c->offset & mask;
+    const size_t first = std::min(pending, m_ring.size() - start);
+
+    buffers[0] = boost::asio::const_buffer(m_ring.data() + start, first);
+    buffers[1] = boost::asio::const_buffer(m_ring.data(), pending - first);
+  }
+
+  c->socket.async_write_some(buffers,
+      [this, c](const boost::system::error_code& error, size_t written)
+      {
+        if (error)
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+
+          remove(c);
+
+          return;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+
+          c->offset += written;
+        }
+
+        send(c);
+      });
+}
+
+void stream_server::remove(std::shared_ptr<client> c)
+{
+  boost::system::error_code ignored;
+
+  c->socket.close(ignored);
+
+  m_clients.remove(c);
+}
+
+unsigned short stream_server::port() const
+{
+  return m_acceptor.local_endpoint().port();
+}
+
+size_t stream_server::clients()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_clients.size();
+}
+
+size_t stream_server::dropped()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_dropped;
+}
+
+} // namespace cracl
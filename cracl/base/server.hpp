@@ -0,0 +1,121 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_SERVER_HPP
+#define CRACL_BASE_SERVER_HPP
+
+#include <boost/asio.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cracl
+{
+
+/* @brief Streams bytes published by one thread to any number of TCP clients
+ *
+ * Published bytes are copied once into a ring shared by every client, and
+ * each client only keeps its own offset into it. Clients are served from a
+ * background thread with gather writes straight out of the ring (two buffers
+ * when the unsent data wraps), so nothing is copied per client. A client
+ * that falls more than max_lag bytes behind is disconnected; the ring is
+ * several times larger than max_lag so that data queued for a connected
+ * client is never overwritten. Clients only receive data published after
+ * they connect.
+ */
+class stream_server
+{
+  struct client
+  {
+    boost::asio::ip::tcp::socket socket;
+
+    // Position of the first byte not yet sent
+    uint64_t offset;
+
+    bool writing;
+    bool lagging;
+
+    client(boost::asio::io_service& io);
+  };
+
+  boost::asio::io_service m_io;
+  std::unique_ptr<boost::asio::io_service::work> m_work;
+  boost::asio::ip::tcp::acceptor m_acceptor;
+
+  std::vector<uint8_t> m_ring;
+  size_t m_max_lag;
+
+  // Guards everything below, which is shared with the publishing thread
+  std::mutex m_mutex;
+
+  uint64_t m_head;
+  std::list<std::shared_ptr<client>> m_clients;
+  size_t m_dropped;
+
+  std::thread m_thread;
+
+  void accept();
+
+  /* @brief Send whatever is unsent to a client, or disconnect it if it has
+   *        fallen too far behind (server thread only)
+   */
+  void send(std::shared_ptr<client> c);
+
+  /* @brief Close and forget a client (server thread only)
+   */
+  void remove(std::shared_ptr<client> c);
+
+public:
+  /* @param port TCP port to listen on, 0 to pick a free one
+   * @param address Address to listen on, e.g. "0.0.0.0" to serve the LAN
+   * @param max_lag Most bytes a client may fall behind before it is
+   *        disconnected
+   */
+  stream_server(unsigned short port, const std::string& address="127.0.0.1",
+      size_t max_lag=262144);
+
+  ~stream_server();
+
+  stream_server(const stream_server&) = delete;
+
+  stream_server& operator=(const stream_server&) = delete;
+
+  /* @brief Queue bytes for every connected client (single producer only)
+   */
+  void publish(const uint8_t* data, size_t size);
+
+  unsigned short port() const;
+
+  size_t clients();
+
+  /* @brief Clients disconnected for falling too far behind
+   */
+  size_t dropped();
+
+};
+
+} // namespace cracl
+
+#endif // CRACL_BASE_SERVER_HPP
@@ -0,0 +1,431 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "shm.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cracl
+{
+
+namespace shm
+{
+
+namespace detail
+{
+
+struct header
+{
+  // Written last, once everything else is initialized
+  std::atomic<uint64_t> magic;
+
+  uint32_t version;
+  uint32_t slot_count;
+  uint32_t slot_words;
+  uint32_t latest_count;
+  uint32_t latest_words;
+  uint32_t reserved;
+
+  std::atomic<uint64_t> head;
+  std::atomic<uint32_t> open;
+};
+
+} // namespace detail
+
+namespace
+{
+
+const uint64_t object_magic = 0x6d68736c63617263; // "craclshm"
+const uint32_t object_version = 1;
+
+/* @brief Byte offsets of each part of the object, parts are aligned to cache
+ *        lines so the header and slots don't share one
+ */
+struct layout
+{
+  size_t slots;
+  size_t words;
+  size_t latest;
+  size_t latest_words;
+  size_t length;
+
+  layout(size_t slot_count, size_t slot_words, size_t latest_count,
+      size_t latest_slot_words)
+  {
+    slots = align(sizeof (detail::header));
+    words = align(slots + slot_count * sizeof (frame_slot));
+    latest = align(words + slot_count * slot_words * 8);
+    latest_words = align(latest + latest_count * sizeof (frame_slot));
+    length = latest_words + latest_count * latest_slot_words * 8;
+  }
+
+  static size_t align(size_t offset)
+  {
+    return (offset + 63) & ~static_cast<size_t>(63);
+  }
+};
+
+int64_t nanoseconds(clock::time_point t)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      t.time_since_epoch()).count();
+}
+
+clock::time_point time_point(int64_t ns)
+{
+  return clock::time_point(std::chrono::duration_cast<clock::duration>(
+        std::chrono::nanoseconds(ns)));
+}
+
+uint32_t latest_key(uint8_t msg_class, uint8_t msg_id)
+{
+  return static_cast<uint32_t>(msg_class) << 8 | msg_id;
+}
+
+} // namespace
+
+publisher::publisher(const std::string& name, size_t slots,
+    size_t slot_size, const std::vector<std::pair<uint8_t, uint8_t>>& latest,
+    size_t latest_size)
+  : m_name (name), m_base (nullptr), m_length (0)
+{
+  if (slots == 0)
+    throw std::runtime_error("Shared memory ring needs at least one slot");
+
+  const size_t slot_words = (slot_size + 7) / 8;
+  const size_t latest_words = (latest_size + 7) / 8;
+
+  layout l(slots, slot_words, latest.size(), latest_words);
+
+  // Replace an object left behind by a publisher that didn't exit cleanly
+  shm_unlink(name.c_str());
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+  if (fd < 0)
+    throw std::runtime_error("Could not create shared memory object " + name
+        + ": " + std::strerror(errno));
+
+  if (ftruncate(fd, l.length) != 0)
+  {
+    const int error = errno;
+
+    close(fd);
+    shm_unlink(name.c_str());
+
+    throw std::runtime_error("Could not size shared memory object " + name
+        + ": " + std::strerror(error));
+  }
+
+  m_base = mmap(nullptr, l.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+  close(fd);
+
+  if (m_base == MAP_FAILED)
+  {
+    shm_unlink(name.c_str());
+
+    throw std::runtime_error("Could not map shared memory object " + name);
+  }
+
+  m_length = l.length;
+
+  uint8_t* base = static_cast<uint8_t*>(m_base);
+
+  m_header = new (base) detail::header;
+  m_slots = reinterpret_cast<frame_slot*>(base + l.slots);
+  m_words = reinterpret_cast<std::atomic<uint64_t>*>(base + l.words);
+  m_latest = reinterpret_cast<frame_slot*>(base + l.latest);
+  m_latest_words = reinterpret_cast<std::atomic<uint64_t>*>(
+      base + l.latest_words);
+
+  for (size_t i = 0; i < slots; ++i)
+    new (m_slots + i) frame_slot;
+
+  for (size_t i = 0; i < latest.size(); ++i)
+  {
+    new (m_latest + i) frame_slot;
+
+    m_latest[i].clear();
+    m_latest[i].tag.store(latest_key(latest[i].first, latest[i].second),
+        std::memory_order_relaxed);
+  }
+
+  // A new object is zero filled, which is a valid initial state for the
+  //   remaining slots and words
+
+  m_header->version = object_version;
+  m_header->slot_count = static_cast<uint32_t>(slots);
+  m_header->slot_words = static_cast<uint32_t>(slot_words);
+  m_header->latest_count = static_cast<uint32_t>(latest.size());
+  m_header->latest_words = static_cast<uint32_t>(latest_words);
+  m_header->reserved = 0;
+  m_header->head.store(0, std::memory_order_relaxed);
+  m_header->open.store(1, std::memory_order_relaxed);
+
+  m_header->magic.store(object_magic, std::memory_order_release);
+}
+
+publisher::~publisher()
+{
+  m_header->open.store(0, std::memory_order_release);
+
+  munmap(m_base, m_length);
+
+  shm_unlink(m_name.c_str());
+}
+
+bool publisher::publish(kind k, const uint8_t* frame, size_t size,
+    clock::time_point arrival)
+{
+  const size_t slot_words = m_header->slot_words;
+
+  if (size > slot_words * 8)
+    return false;
+
+  const uint64_t position = m_header->head.load(std::memory_order_relaxed);
+  const size_t index = position % m_header->slot_count;
+
+  m_slots[index].store(m_words + index * slot_words, 2 * position + 2, frame,
+      size, k, nanoseconds(arrival));
+
+  m_header->head.store(position + 1, std::memory_order_release);
+
+  return true;
+}
+
+bool publisher::update_latest(const uint8_t* frame, size_t size,
+    clock::time_point arrival)
+{
+  const size_t latest_words = m_header->latest_words;
+
+  if (size < 8 || size > latest_words * 8)
+    return false;
+
+  const uint32_t key = latest_key(frame[2], frame[3]);
+
+  for (size_t i = 0; i < m_header->latest_count; ++i)
+  {
+    frame_slot& slot = m_latest[i];
+
+    if (slot.tag.load(std::memory_order_relaxed) == key)
+    {
+      slot.store(m_latest_words + i * latest_words,
+          slot.sequence.load(std::memory_order_relaxed) + 2, frame, size, key,
+          nanoseconds(arrival));
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+const std::string& publisher::name() const
+{
+  return m_name;
+}
+
+reader::reader(const std::string& name)
+  : m_base (nullptr), m_length (0), m_position (0), m_overruns (0)
+{
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+
+  if (fd < 0)
+    throw std::runtime_error("Could not open shared memory object " + name
+        + ": " + std::strerror(errno));
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0
+      || static_cast<size_t>(st.st_size) < sizeof (detail::header))
+  {
+    close(fd);
+
+    throw std::runtime_error("Shared memory object " + name
+        + " is not ready");
+  }
+
+  m_length = st.st_size;
+  m_base = mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd, 0);
+
+  close(fd);
+
+  if (m_base == MAP_FAILED)
+    throw std::runtime_error("Could not map shared memory object " + name);
+
+  const uint8_t* base = static_cast<const uint8_t*>(m_base);
+
+  m_header = reinterpret_cast<const detail::header*>(base);
+
+  if (m_header->magic.load(std::memory_order_acquire) != object_magic
+      || m_header->version != object_version)
+  {
+    munmap(m_base, m_length);
+
+    throw std::runtime_error("Shared memory object " + name
+        + " was not created by a compatible publisher");
+  }
+
+  layout l(m_header->slot_count, m_header->slot_words,
+      m_header->latest_count, m_header->latest_words);
+
+  if (l.length > m_length)
+  {
+    munmap(m_base, m_length);
+
+    throw std::runtime_error("Shared memory object " + name
+        + " is truncated");
+  }
+
+  m_slots = reinterpret_cast<const frame_slot*>(base + l.slots);
+  m_words = reinterpret_cast<const std::atomic<uint64_t>*>(base + l.words);
+  m_latest = reinterpret_cast<const frame_slot*>(base + l.latest);
+  m_latest_words = reinterpret_cast<const std::atomic<uint64_t>*>(
+      base + l.latest_words);
+
+  m_position = m_header->head.load(std::memory_order_acquire);
+}
+
+reader::~reader()
+{
+  munmap(m_base, m_length);
+}
+
+bool reader::next(uint8_t* buffer, size_t buffer_size, size_t& size,
+    kind& k, clock::time_point* arrival)
+{
+  const size_t slot_count = m_header->slot_count;
+
+  while (true)
+  {
+    const uint64_t head = m_header->head.load(std::memory_order_acquire);
+
+    if (m_position >= head)
+      return false;
+
+    // Fell more than a ring behind, skip to the oldest frame that isn't
+    //   about to be overwritten
+    if (head - m_position >= slot_count)
+    {
+      const uint64_t oldest = head - slot_count + 1;
+
+      m_overruns += oldest - m_position;
+      m_position = oldest;
+    }
+
+    const size_t index = m_position % slot_count;
+
+    uint32_t tag;
+    int64_t ns;
+
+    if (m_slots[index].load(m_words + index * m_header->slot_words, buffer,
+          buffer_size, size, &tag, &ns) != 2 * m_position + 2)
+      continue;
+
+    k = static_cast<kind>(tag);
+
+    if (arrival)
+      *arrival = time_point(ns);
+
+    ++m_position;
+
+    return true;
+  }
+}
+
+bool reader::wait(size_t timeout)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::milliseconds(timeout);
+  auto spin_until = start + std::chrono::microseconds(100);
+
+  while (available() == 0)
+  {
+    auto now = std::chrono::steady_clock::now();
+
+    if (now >= deadline)
+      return false;
+
+    if (now >= spin_until)
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+  return true;
+}
+
+uint64_t reader::latest(uint8_t msg_class, uint8_t msg_id, uint8_t* buffer,
+    size_t buffer_size, size_t& size, clock::time_point* arrival) const
+{
+  const uint32_t key = latest_key(msg_class, msg_id);
+
+  for (size_t i = 0; i < m_header->latest_count; ++i)
+    if (m_latest[i].tag.load(std::memory_order_relaxed) == key)
+    {
+      int64_t ns;
+
+      const uint64_t sequence = m_latest[i].load(m_latest_words
+          + i * m_header->latest_words, buffer, buffer_size, size, nullptr,
+          &ns);
+
+      if (arrival)
+        *arrival = time_point(ns);
+
+      return sequence / 2;
+    }
+
+  size = 0;
+
+  return 0;
+}
+
+uint64_t reader::available() const
+{
+  return m_header->head.load(std::memory_order_acquire) - m_position;
+}
+
+uint64_t reader::overruns() const
+{
+  return m_overruns;
+}
+
+bool reader::open() const
+{
+  return m_header->open.load(std::memory_order_acquire) != 0;
+}
+
+} // namespace shm
+
+} // namespace cracl
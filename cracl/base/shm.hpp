@@ -0,0 +1,185 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_SHM_HPP
+#define CRACL_BASE_SHM_HPP
+
+#include "frame_slot.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cracl
+{
+
+namespace shm
+{
+
+/* @brief Kind of frame, recorded with each frame published
+ */
+enum kind : uint32_t { ubx = 1, nmea = 2, rtcm = 3, scpi = 4 };
+
+typedef std::chrono::system_clock clock;
+
+namespace detail
+{
+
+struct header;
+
+} // namespace detail
+
+/* @brief Publishes frames from a device to other processes through a POSIX
+ *        shared memory object
+ *
+ * The object holds a ring of frames, read by any number of processes with
+ * their own cursors as with cracl::broadcast, plus a fixed set of
+ * latest-value slots (keyed by UBX class and ID) for state-style messages.
+ * Readers map the object read only and never block the publisher. The object
+ * is removed when the publisher is destroyed.
+ */
+class publisher
+{
+  std::string m_name;
+
+  void* m_base;
+  size_t m_length;
+
+  detail::header* m_header;
+  frame_slot* m_slots;
+  std::atomic<uint64_t>* m_words;
+  frame_slot* m_latest;
+  std::atomic<uint64_t>* m_latest_words;
+
+public:
+  /* @param name Name of the shared memory object (e.g. "/cracl-ttyACM0"), an
+   *        existing object of the same name is replaced
+   * @param slots Number of frames held in the ring
+   * @param slot_size Largest frame published, in bytes
+   * @param latest UBX message types (class and ID) to keep latest values of
+   * @param latest_size Largest latest-value frame, in bytes
+   */
+  publisher(const std::string& name, size_t slots=1024,
+      size_t slot_size=2048,
+      const std::vector<std::pair<uint8_t, uint8_t>>& latest={},
+      size_t latest_size=256);
+
+  ~publisher();
+
+  publisher(const publisher&) = delete;
+
+  publisher& operator=(const publisher&) = delete;
+
+  /* @brief Publish a frame to the ring (single producer only)
+   *
+   * @return False if the frame is larger than a slot and was not published
+   */
+  bool publish(kind k, const uint8_t* frame, size_t size,
+      clock::time_point arrival=clock::now());
+
+  /* @brief Store a UBX frame in its latest-value slot, if it has one
+   *
+   * @return True if the frame was stored
+   */
+  bool update_latest(const uint8_t* frame, size_t size,
+      clock::time_point arrival=clock::now());
+
+  const std::string& name() const;
+
+};
+
+/* @brief Reads frames published by a shm::publisher in another process
+ */
+class reader
+{
+  void* m_base;
+  size_t m_length;
+
+  const detail::header* m_header;
+  const frame_slot* m_slots;
+  const std::atomic<uint64_t>* m_words;
+  const frame_slot* m_latest;
+  const std::atomic<uint64_t>* m_latest_words;
+
+  uint64_t m_position;
+  uint64_t m_overruns;
+
+public:
+  /* @brief Open a published object, starting after the newest frame
+   */
+  reader(const std::string& name);
+
+  ~reader();
+
+  reader(const reader&) = delete;
+
+  reader& operator=(const reader&) = delete;
+
+  /* @brief Copy the next frame into a buffer
+   *
+   * @param size Set to the size of the frame, which is only partly copied if
+   *        larger than the buffer
+   * @param k Set to the kind of frame
+   * @param arrival Set to the time the publisher received the frame, if given
+   *
+   * @return False if no new frame has been published
+   */
+  bool next(uint8_t* buffer, size_t buffer_size, size_t& size, kind& k,
+      clock::time_point* arrival=nullptr);
+
+  /* @brief Poll until a new frame is published or the timeout expires. Spins
+   *        briefly before sleeping, so a frame is usually picked up within
+   *        microseconds
+   *
+   * @param timeout Time in milliseconds to wait
+   *
+   * @return True if a frame is available
+   */
+  bool wait(size_t timeout);
+
+  /* @brief Copy the latest value of a UBX message type
+   *
+   * @return Number of updates made to the value when it was copied, 0 if the
+   *         type isn't published or nothing has been received yet
+   */
+  uint64_t latest(uint8_t msg_class, uint8_t msg_id, uint8_t* buffer,
+      size_t buffer_size, size_t& size,
+      clock::time_point* arrival=nullptr) const;
+
+  uint64_t available() const;
+
+  /* @brief Frames skipped because the reader fell behind
+   */
+  uint64_t overruns() const;
+
+  /* @brief False once the publisher has been destroyed
+   */
+  bool open() const;
+
+};
+
+} // namespace shm
+
+} // namespace cracl
+
+#endif // CRACL_BASE_SHM_HPP
@@ -0,0 +1,64 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "termios2.hpp"
+
+#ifdef __linux__
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+#endif
+
+#include <cstddef>
+
+namespace cracl
+{
+
+namespace termios2
+{
+
+bool set_baud_rate(int fd, size_t baud_rate)
+{
+#if defined(__linux__) && defined(BOTHER)
+  struct termios2 tio;
+
+  if (ioctl(fd, TCGETS2, &tio) != 0)
+    return false;
+
+  tio.c_cflag &= ~CBAUD;
+  tio.c_cflag |= BOTHER;
+  tio.c_ispeed = baud_rate;
+  tio.c_ospeed = baud_rate;
+
+  // The input speed has its own BOTHER field above IBSHIFT
+  tio.c_cflag &= ~(CBAUD << IBSHIFT);
+  tio.c_cflag |= BOTHER << IBSHIFT;
+
+  return ioctl(fd, TCSETS2, &tio) == 0;
+#else
+  (void) fd;
+  (void) baud_rate;
+
+  return false;
+#endif
+}
+
+} // namespace termios2
+
+} // namespace cracl
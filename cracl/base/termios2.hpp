@@ -0,0 +1,46 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_BASE_TERMIOS2_HPP
+#define CRACL_BASE_TERMIOS2_HPP
+
+#include <cstddef>
+
+namespace cracl
+{
+
+namespace termios2
+{
+
+/* @brief Set an arbitrary baud rate on a serial port file descriptor using
+ *        termios2 and BOTHER, for rates without a standard B* constant
+ *
+ * Kept in its own translation unit since <asm/termbits.h> conflicts with the
+ * <termios.h> used by Boost ASIO.
+ *
+ * @return False if the rate could not be set, or if termios2 is unavailable
+ */
+bool set_baud_rate(int fd, size_t baud_rate);
+
+} // namespace termios2
+
+} // namespace cracl
+
+#endif // CRACL_BASE_TERMIOS2_HPP
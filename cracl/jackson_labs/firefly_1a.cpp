@@ -24,6 +24,7 @@
 
 #include <array>
 #include <deque>
+#include <memory>
 #include <string>
 
 namespace cracl
@@ -60,6 +61,9 @@ void firefly_1a::buffer_messages()
       message.push_back(read_byte());
       message.push_back(read_byte());
 
+      if (m_shm)
+        m_shm->publish(shm::nmea, message.data(), message.size());
+
       m_nmea_buffer.push_back(message);
 
       // Consume '\r\n'
@@ -78,6 +82,9 @@ void firefly_1a::buffer_messages()
               && message.at(message.size() - 4) == '\r')))    //   read
         message.push_back(current = read_byte());
 
+      if (m_shm)
+        m_shm->publish(shm::scpi, message.data(), message.size());
+
       m_scpi_buffer.push_back(message);
 
       // Consume 'scpi > '
@@ -139,6 +146,16 @@ void firefly_1a::flush_scpi()
   m_scpi_buffer.clear();
 }
 
+shm::publisher& firefly_1a::share(const std::string& name, size_t slots,
+    size_t slot_size)
+{
+  // Remove the old object first, the new one may have the same name
+  m_shm.reset();
+  m_shm.reset(new shm::publisher(name, slots, slot_size));
+
+  return *m_shm;
+}
+
 void firefly_1a::gps()
 {
   write("GPS?\r\n");
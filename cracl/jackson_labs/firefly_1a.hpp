@@ -22,9 +22,11 @@
 #define CRACL_JACKSON_LABS_FIREFLY_1A_HPP
 
 #include "../base/device.hpp"
+#include "../base/shm.hpp"
 
 #include <array>
 #include <deque>
+#include <memory>
 #include <string>
 
 namespace cracl
@@ -37,6 +39,8 @@ class firefly_1a : public device
   std::deque<std::vector<uint8_t>> m_nmea_buffer;
   std::deque<std::vector<uint8_t>> m_scpi_buffer;
 
+  std::unique_ptr<shm::publisher> m_shm;
+
   void buffer_messages();
 
 public:
@@ -59,6 +63,13 @@ public:
 
   void flush_scpi();
 
+  /* @brief Publish every NMEA sentence and SCPI response received to other
+   *        processes through a shared memory object, read with shm::reader.
+   *        Replaces any object shared before
+   */
+  shm::publisher& share(const std::string& name, size_t slots=1024,
+      size_t slot_size=2048);
+
   //template <typename... Args>
   //void scpi_send(std::string&& msg_id, Args... args);
 
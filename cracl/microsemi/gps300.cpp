@@ -24,6 +24,7 @@
 
 #include <array>
 #include <deque>
+#include <memory>
 #include <string>
 
 namespace cracl
@@ -86,6 +87,9 @@ void gps300::buffer_messages()
       message.push_back(read_byte());
       message.push_back(read_byte());
 
+      if (m_shm)
+        m_shm->publish(shm::nmea, message.data(), message.size());
+
       m_nmea_buffer.push_back(message);
 
       // Consume '\r\n'
@@ -100,6 +104,9 @@ void gps300::buffer_messages()
 
       message.insert(message.begin() + 1, temp.begin(), temp.end());
 
+      if (m_shm)
+        m_shm->publish(shm::scpi, message.data(), message.size());
+
       m_scpi_buffer.push_back(message);
 
       // Consume 'scpi > '
@@ -161,6 +168,16 @@ void gps300::flush_scpi()
   m_scpi_buffer.clear();
 }
 
+shm::publisher& gps300::share(const std::string& name, size_t slots,
+    size_t slot_size)
+{
+  // Remove the old object first, the new one may have the same name
+  m_shm.reset();
+  m_shm.reset(new shm::publisher(name, slots, slot_size));
+
+  return *m_shm;
+}
+
 //template <typename... Args>
 //void gps300::scpi_send(std::string&& msg_id, Args... args)
 //{
@@ -0,0 +1,173 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "frame.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace cracl
+{
+
+namespace rtcm
+{
+
+namespace
+{
+
+struct crc_table
+{
+  uint32_t value[256];
+};
+
+constexpr crc_table make_crc_table()
+{
+  crc_table table = {};
+
+  // Generator polynomial 0x1864CFB, MSB first
+  for (uint32_t i = 0; i < 256; ++i)
+  {
+    uint32_t crc = i << 16;
+
+    for (size_t bit = 0; bit < 8; ++bit)
+    {
+      crc <<= 1;
+
+      if (crc & 0x1000000)
+        crc ^= 0x1864cfb;
+    }
+
+    table.value[i] = crc & 0xffffff;
+  }
+
+  return table;
+}
+
+constexpr crc_table table = make_crc_table();
+
+} // namespace
+
+uint32_t crc24q(const uint8_t* data, size_t size, uint32_t crc)
+{
+  for (size_t i = 0; i < size; ++i)
+    crc = ((crc << 8) & 0xffffff) ^ table.value[(crc >> 16) ^ data[i]];
+
+  return crc;
+}
+
+size_t payload_length(const uint8_t* header)
+{
+  return ((header[1] & 0x03) << 8) | header[2];
+}
+
+uint16_t message_number(const std::vector<uint8_t>& frame)
+{
+  if (frame.size() < header_size + 2)
+    return 0;
+
+  return (frame[3] << 4) | (frame[4] >> 4);
+}
+
+bool valid(const std::vector<uint8_t>& frame)
+{
+  if (frame.size() < header_size + crc_size || frame[0] != preamble
+      || (frame[1] & 0xfc) != 0
+      || frame.size() != header_size + payload_length(frame.data())
+        + crc_size)
+    return false;
+
+  const size_t end = frame.size() - crc_size;
+
+  const uint32_t crc = (frame[end] << 16) | (frame[end + 1] << 8)
+    | frame[end + 2];
+
+  return crc24q(frame.data(), end) == crc;
+}
+
+size_t finish_frame(uint8_t* frame, size_t payload_size)
+{
+  if (payload_size > max_payload_size)
+    throw std::runtime_error("RTCM payload too long");
+
+  frame[0] = preamble;
+  frame[1] = payload_size >> 8;
+  frame[2] = payload_size & 0xff;
+
+  const size_t end = header_size + payload_size;
+
+  const uint32_t crc = crc24q(frame, end);
+
+  frame[end] = crc >> 16;
+  frame[end + 1] = (crc >> 8) & 0xff;
+  frame[end + 2] = crc & 0xff;
+
+  return end + crc_size;
+}
+
+bit_writer::bit_writer(uint8_t* data, size_t capacity)
+  : m_data(data), m_capacity(capacity), m_bits(0)
+{ }
+
+void bit_writer::put(uint64_t value, size_t bits)
+{
+  if (bits > 64 || m_bits + bits > 8 * m_capacity)
+    throw std::runtime_error("RTCM message too long");
+
+  // Fill the current byte, then whole bytes, from the top of the field down
+  while (bits > 0)
+  {
+    const size_t offset = m_bits & 0x07;
+    const size_t count = std::min(bits, 8 - offset);
+
+    const uint8_t chunk = (value >> (bits - count)) & ((1u << count) - 1);
+
+    uint8_t& byte = m_data[m_bits >> 3];
+
+    if (offset == 0)
+      byte = 0;
+
+    byte |= chunk << (8 - offset - count);
+
+    m_bits += count;
+    bits -= count;
+  }
+}
+
+void bit_writer::put_signed(int64_t value, size_t bits)
+{
+  put(static_cast<uint64_t>(value), bits);
+}
+
+size_t bit_writer::bits() const
+{
+  return m_bits;
+}
+
+size_t bit_writer::size() const
+{
+  return (m_bits + 7) / 8;
+}
+
+} // namespace rtcm
+
+} // namespace cracl
@@ -0,0 +1,102 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_RTCM_FRAME_HPP
+#define CRACL_RTCM_FRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cracl
+{
+
+namespace rtcm
+{
+
+// Frame layout: preamble (0xD3), 6 reserved bits, 10 bit payload length,
+//   payload, 24 bit CRC
+const uint8_t preamble = 0xd3;
+
+const size_t header_size = 3;
+
+const size_t crc_size = 3;
+
+const size_t max_payload_size = 1023;
+
+/* @brief CRC-24Q (Qualcomm) as used by RTCM3, computed a byte at a time from
+ *        a 256 entry table
+ *
+ * @param crc Value to continue from when checking data in pieces
+ */
+uint32_t crc24q(const uint8_t* data, size_t size, uint32_t crc=0);
+
+/* @brief Payload length from the first three bytes of a frame
+ */
+size_t payload_length(const uint8_t* header);
+
+/* @brief Message number (first 12 bits of the payload) of a frame
+ */
+uint16_t message_number(const std::vector<uint8_t>& frame);
+
+/* @brief Confirms a frame has a valid preamble, length and CRC
+ */
+bool valid(const std::vector<uint8_t>& frame);
+
+/* @brief Complete a frame whose payload has already been written at
+ *        frame + header_size, by filling in the header and appending the CRC
+ *
+ * @return Total size of the frame
+ */
+size_t finish_frame(uint8_t* frame, size_t payload_size);
+
+/* @brief Packs fields MSB first into a caller provided buffer, as RTCM3
+ *        payloads are laid out
+ */
+class bit_writer
+{
+  uint8_t* m_data;
+  size_t m_capacity;
+  size_t m_bits;
+
+public:
+  bit_writer(uint8_t* data, size_t capacity);
+
+  /* @brief Append the low bits of value (at most 64)
+   */
+  void put(uint64_t value, size_t bits);
+
+  /* @brief Append a two's complement signed field
+   */
+  void put_signed(int64_t value, size_t bits);
+
+  size_t bits() const;
+
+  /* @brief Bytes used, with the last byte zero padded
+   */
+  size_t size() const;
+
+};
+
+} // namespace rtcm
+
+} // namespace cracl
+
+#endif // CRACL_RTCM_FRAME_HPP
@@ -0,0 +1,575 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "msm.hpp"
+#include "frame.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace cracl
+{
+
+namespace rtcm
+{
+
+namespace
+{
+
+const double speed_of_light = 299792458.0;
+
+// MSM ranges are expressed in light milliseconds
+const double range_ms = speed_of_light * 1e-3;
+
+const double nan = std::numeric_limits<double>::quiet_NaN();
+
+// Constellations in the order messages are written, with the MSM1 message
+//   number of each (MSMn is that plus n - 1)
+struct constellation
+{
+  uint8_t gnssId;
+  uint16_t msm1;
+};
+
+const constellation systems[] = {
+  { 0, 1071 }, // GPS
+  { 6, 1081 }, // GLONASS
+  { 2, 1091 }, // Galileo
+  { 3, 1121 }  // BeiDou
+};
+
+const size_t system_count = sizeof (systems) / sizeof (systems[0]);
+
+/* @brief MSM signal ID (1-32) of a UBX signal, 0 if there is none
+ */
+uint8_t signal_id(uint8_t gnssId, uint8_t sigId)
+{
+  switch (gnssId)
+  {
+    case 0: // GPS
+      switch (sigId)
+      {
+        case 0: return 2;   // L1C/A - 1C
+        case 3: return 16;  // L2 CL - 2L
+        case 4: return 15;  // L2 CM - 2S
+        case 6: return 22;  // L5 I - 5I
+        case 7: return 23;  // L5 Q - 5Q
+      }
+      break;
+    case 2: // Galileo
+      switch (sigId)
+      {
+        case 0: return 2;   // E1 C - 1C
+        case 1: return 4;   // E1 B - 1B
+        case 3: return 22;  // E5a I - 5I
+        case 4: return 23;  // E5a Q - 5Q
+        case 5: return 14;  // E5b I - 7I
+        case 6: return 15;  // E5b Q - 7Q
+      }
+      break;
+    case 3: // BeiDou
+      switch (sigId)
+      {
+        case 0:             // B1I D1 - 2I
+        case 1: return 2;   // B1I D2 - 2I
+        case 2:             // B2I D1 - 7I
+        case 3: return 14;  // B2I D2 - 7I
+      }
+      break;
+    case 6: // GLONASS
+      switch (sigId)
+      {
+        case 0: return 2;   // L1 OF - 1C
+        case 2: return 8;   // L2 OF - 2C
+      }
+      break;
+  }
+
+  return 0;
+}
+
+/* @brief Carrier frequency of a UBX signal in Hz, freqId is the GLONASS
+ *        frequency slot + 7
+ */
+double frequency(uint8_t gnssId, uint8_t sigId, uint8_t freqId)
+{
+  switch (gnssId)
+  {
+    case 0:
+      return sigId == 0 ? 1575.42e6 : sigId <= 4 ? 1227.60e6 : 1176.45e6;
+    case 2:
+      return sigId <= 1 ? 1575.42e6 : sigId <= 4 ? 1176.45e6 : 1207.14e6;
+    case 3:
+      return sigId <= 1 ? 1561.098e6 : 1207.14e6;
+    case 6:
+      return sigId == 0 ? 1602.0e6 + (freqId - 7) * 0.5625e6
+        : 1246.0e6 + (freqId - 7) * 0.4375e6;
+  }
+
+  return 0;
+}
+
+/* @brief DF402 lock time indicator (4 bits)
+ */
+uint32_t lock_indicator(uint32_t lock)
+{
+  uint32_t indicator = 0;
+
+  while (indicator < 15 && lock >= (32u << indicator))
+    ++indicator;
+
+  return indicator;
+}
+
+/* @brief DF407 extended lock time indicator (10 bits)
+ */
+uint32_t lock_indicator_extended(uint32_t lock)
+{
+  if (lock < 64)
+    return lock;
+
+  // Blocks of 32 values, block k covering 2^(k+5) to 2^(k+6) ms in steps of
+  //   2^k ms
+  uint32_t k = 1;
+
+  while (k < 21 && lock >= (64u << k))
+    ++k;
+
+  if (k == 21)
+    return 704;
+
+  return (lock >> k) + 32 * k;
+}
+
+/* @brief Scale a value to an integer field of the given width, or return the
+ *        field's invalid value (most negative) if it doesn't fit
+ */
+int64_t scaled(double value, double unit, size_t bits)
+{
+  const int64_t limit = int64_t(1) << (bits - 1);
+
+  if (std::isnan(value))
+    return -limit;
+
+  const double x = std::round(value / unit);
+
+  if (x <= -limit || x >= limit)
+    return -limit;
+
+  return static_cast<int64_t>(x);
+}
+
+} // namespace
+
+msm_encoder::msm_encoder(uint16_t station_id, type msm)
+  : m_station_id(station_id), m_type(msm), m_rcvTow(0), m_leapS(0),
+    m_count(0)
+{ }
+
+size_t msm_encoder::encode(uint8_t* data, size_t capacity)
+{
+  // Convert every observation to MSM units, and keep phase continuous
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    const observation& obs = m_observations[i];
+    cell& c = m_cells[i];
+
+    c.signal = signal_id(obs.gnssId, obs.sigId);
+
+    // Pseudorange is required for every cell, satellite IDs must fit the mask
+    if (c.signal == 0 || !(obs.trkStat & 0x01) || obs.svId == 0
+        || obs.svId > 64)
+    {
+      c.signal = 0;
+
+      continue;
+    }
+
+    const double wavelength = speed_of_light
+      / frequency(obs.gnssId, obs.sigId, obs.freqId);
+
+    c.range = obs.prMes / range_ms;
+    c.rate = -obs.doMes * wavelength;
+    c.half_cycle = !(obs.trkStat & 0x04);
+
+    const uint32_t key = (obs.gnssId << 16) | (obs.svId << 8) | obs.sigId;
+
+    if (!(obs.trkStat & 0x02))
+    {
+      c.phase = nan;
+      c.lock = 0;
+
+      m_phase[key].valid = false;
+
+      continue;
+    }
+
+    auto found = m_phase.find(key);
+
+    phase_state& state = m_phase[key];
+
+    // A new signal, or lock time going backwards, is a fresh lock
+    bool anchor = found == m_phase.end() || obs.locktime < state.locktime;
+
+    if (anchor)
+      state.anchor = 0;
+    else if (!state.valid)
+    {
+      anchor = true;
+      state.anchor = obs.locktime;
+    }
+
+    c.phase = (obs.cpMes - state.offset) * wavelength / range_ms;
+
+    // Shift again if code and carrier have drifted too far apart for the
+    //   fine phase field (half of its 2^-8 ms range)
+    if (!anchor && std::fabs(c.phase - c.range) > 1.0 / 512)
+    {
+      anchor = true;
+      state.anchor = obs.locktime;
+    }
+
+    if (anchor)
+    {
+      state.offset = std::llround(obs.cpMes - obs.prMes / wavelength);
+
+      c.phase = (obs.cpMes - state.offset) * wavelength / range_ms;
+    }
+
+    state.locktime = obs.locktime;
+    state.valid = true;
+
+    c.lock = obs.locktime - state.anchor;
+  }
+
+  // Plan the messages: satellites of a constellation are split across
+  //   several messages if satellites x signals exceeds the 64 cell limit
+  struct message
+  {
+    size_t system;
+    uint64_t sats;
+    uint32_t sigs;
+  };
+
+  std::array<message, 4 * 32> messages;
+  size_t count = 0;
+
+  for (size_t s = 0; s < system_count; ++s)
+  {
+    uint64_t sats = 0;
+    uint32_t sigs = 0;
+
+    for (size_t i = 0; i < m_count; ++i)
+      if (m_cells[i].signal != 0
+          && m_observations[i].gnssId == systems[s].gnssId)
+      {
+        sats |= uint64_t(1) << (64 - m_observations[i].svId);
+        sigs |= uint32_t(1) << (32 - m_cells[i].signal);
+      }
+
+    if (sats == 0)
+      continue;
+
+    const size_t per_message = 64 / std::bitset<32>(sigs).count();
+
+    uint64_t group = 0;
+    size_t in_group = 0;
+
+    for (size_t sv = 1; sv <= 64; ++sv)
+    {
+      const uint64_t bit = uint64_t(1) << (64 - sv);
+
+      if (!(sats & bit))
+        continue;
+
+      group |= bit;
+
+      if (++in_group == per_message)
+      {
+        messages[count++] = message{ s, group, sigs };
+
+        group = 0;
+        in_group = 0;
+      }
+    }
+
+    if (group != 0)
+      messages[count++] = message{ s, group, sigs };
+  }
+
+  size_t size = 0;
+
+  for (size_t i = 0; i < count; ++i)
+    size += encode_message(messages[i].system, messages[i].sats,
+        messages[i].sigs, i + 1 < count, data + size, capacity - size);
+
+  return size;
+}
+
+size_t msm_encoder::encode_message(size_t system, uint64_t sat_mask,
+    uint32_t sig_mask, bool more, uint8_t* data, size_t capacity)
+{
+  if (capacity < header_size + crc_size)
+    throw std::runtime_error("RTCM message too long");
+
+  const constellation& gnss = systems[system];
+
+  bit_writer bits(data + header_size, std::min(capacity - header_size
+        - crc_size, max_payload_size));
+
+  // Satellite and signal lists, and the index of each in the message
+  std::array<uint8_t, 64> sats;
+  std::array<uint8_t, 32> sigs;
+  std::array<int8_t, 65> sat_index;
+  std::array<int8_t, 33> sig_index;
+
+  size_t nsat = 0;
+  size_t nsig = 0;
+
+  sat_index.fill(-1);
+  sig_index.fill(-1);
+
+  for (size_t sv = 1; sv <= 64; ++sv)
+    if (sat_mask & (uint64_t(1) << (64 - sv)))
+    {
+      sat_index[sv] = nsat;
+      sats[nsat++] = sv;
+    }
+
+  for (size_t sig = 1; sig <= 32; ++sig)
+    if (sig_mask & (uint32_t(1) << (32 - sig)))
+    {
+      sig_index[sig] = nsig;
+      sigs[nsig++] = sig;
+    }
+
+  // Observation in each cell (satellite major), -1 if empty
+  std::array<int16_t, 64> cells;
+  cells.fill(-1);
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    const observation& obs = m_observations[i];
+
+    if (m_cells[i].signal != 0 && obs.gnssId == gnss.gnssId
+        && sat_index[obs.svId] >= 0)
+    {
+      int16_t& slot = cells[sat_index[obs.svId] * nsig
+        + sig_index[m_cells[i].signal]];
+
+      // Keep the first observation if two UBX signals share an MSM signal
+      if (slot < 0)
+        slot = i;
+    }
+  }
+
+  // Rough range and range rate per satellite, from its first cell
+  std::array<double, 64> rough_range;
+  std::array<double, 64> rough_rate;
+
+  for (size_t s = 0; s < nsat; ++s)
+  {
+    rough_range[s] = nan;
+    rough_rate[s] = nan;
+
+    for (size_t g = 0; g < nsig; ++g)
+    {
+      const int16_t i = cells[s * nsig + g];
+
+      if (i < 0)
+        continue;
+
+      rough_range[s] = std::round(m_cells[i].range * 1024) / 1024;
+      rough_rate[s] = std::round(m_cells[i].rate);
+
+      if (rough_range[s] >= 255)
+        rough_range[s] = nan;
+
+      break;
+    }
+  }
+
+  // Header
+  bits.put(gnss.msm1 + m_type - 1, 12);
+  bits.put(m_station_id, 12);
+
+  const int64_t tow_ms = std::llround(m_rcvTow * 1000);
+  const int64_t week_ms = 604800000;
+
+  switch (gnss.gnssId)
+  {
+    case 6: // GLONASS: day of week and time of day, UTC(SU) + 3 hours
+    {
+      const int64_t t = tow_ms - m_leapS * 1000 + 10800000;
+
+      bits.put((t / 86400000) % 7, 3);
+      bits.put(t % 86400000, 27);
+
+      break;
+    }
+    case 3: // BeiDou: BDT is 14 seconds behind GPS time
+      bits.put((tow_ms - 14000 + week_ms) % week_ms, 30);
+      break;
+    default:
+      bits.put(tow_ms % week_ms, 30);
+  }
+
+  bits.put(more, 1);  // Multiple message bit
+  bits.put(0, 3);     // IODS
+  bits.put(0, 7);     // Reserved
+  bits.put(0, 2);     // Clock steering
+  bits.put(0, 2);     // External clock
+  bits.put(0, 1);     // Divergence free smoothing
+  bits.put(0, 3);     // Smoothing interval
+
+  bits.put(sat_mask, 64);
+  bits.put(sig_mask, 32);
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    bits.put(cells[c] >= 0, 1);
+
+  // Satellite data, each field for every satellite in turn
+  for (size_t s = 0; s < nsat; ++s)
+    bits.put(std::isnan(rough_range[s]) ? 255
+        : static_cast<uint64_t>(rough_range[s]), 8);
+
+  if (m_type == msm7)
+    for (size_t s = 0; s < nsat; ++s)
+    {
+      uint8_t info = 0;
+
+      // GLONASS frequency slot + 7, taken from any of the satellite's cells
+      if (gnss.gnssId == 6)
+        for (size_t g = 0; g < nsig; ++g)
+          if (cells[s * nsig + g] >= 0)
+            info = m_observations[cells[s * nsig + g]].freqId;
+
+      bits.put(info, 4);
+    }
+
+  for (size_t s = 0; s < nsat; ++s)
+    bits.put(std::isnan(rough_range[s]) ? 0
+        : std::llround(std::fmod(rough_range[s], 1.0) * 1024), 10);
+
+  if (m_type == msm7)
+    for (size_t s = 0; s < nsat; ++s)
+      bits.put_signed(scaled(rough_rate[s], 1, 14), 14);
+
+  // Signal data, each field for every non-empty cell in turn
+  const size_t pr_bits = m_type == msm7 ? 20 : 15;
+  const double pr_unit = m_type == msm7 ? std::ldexp(1, -29)
+    : std::ldexp(1, -24);
+
+  const size_t cp_bits = m_type == msm7 ? 24 : 22;
+  const double cp_unit = m_type == msm7 ? std::ldexp(1, -31)
+    : std::ldexp(1, -29);
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    if (cells[c] >= 0)
+      bits.put_signed(scaled(m_cells[cells[c]].range
+            - rough_range[c / nsig], pr_unit, pr_bits), pr_bits);
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    if (cells[c] >= 0)
+      bits.put_signed(scaled(m_cells[cells[c]].phase
+            - rough_range[c / nsig], cp_unit, cp_bits), cp_bits);
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    if (cells[c] >= 0)
+    {
+      if (m_type == msm7)
+        bits.put(lock_indicator_extended(m_cells[cells[c]].lock), 10);
+      else
+        bits.put(lock_indicator(m_cells[cells[c]].lock), 4);
+    }
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    if (cells[c] >= 0)
+      bits.put(m_cells[cells[c]].half_cycle, 1);
+
+  for (size_t c = 0; c < nsat * nsig; ++c)
+    if (cells[c] >= 0)
+    {
+      const uint8_t cno = m_observations[cells[c]].cno;
+
+      if (m_type == msm7)
+        bits.put(std::min(cno * 16, 1023), 10);
+      else
+        bits.put(std::min<int>(cno, 63), 6);
+    }
+
+  if (m_type == msm7)
+    for (size_t c = 0; c < nsat * nsig; ++c)
+      if (cells[c] >= 0)
+        bits.put_signed(scaled(m_cells[cells[c]].rate
+              - rough_rate[c / nsig], 0.0001, 15), 15);
+
+  return finish_frame(data, bits.size());
+}
+
+size_t msm_encoder::encode_station(double x, double y, double z,
+    uint8_t* data, size_t capacity) const
+{
+  if (capacity < header_size + 19 + crc_size)
+    throw std::runtime_error("RTCM message too long");
+
+  bit_writer bits(data + header_size, 19);
+
+  bits.put(1005, 12);
+  bits.put(m_station_id, 12);
+  bits.put(0, 6);       // ITRF realization year
+  bits.put(1, 1);       // GPS
+  bits.put(1, 1);       // GLONASS
+  bits.put(1, 1);       // Galileo
+  bits.put(0, 1);       // Reference station (not physical)
+  bits.put_signed(std::llround(x * 1e4), 38);
+  bits.put(0, 1);       // Single receiver oscillator
+  bits.put(0, 1);       // Reserved
+  bits.put_signed(std::llround(y * 1e4), 38);
+  bits.put(0, 2);       // Quarter cycle indicator
+  bits.put_signed(std::llround(z * 1e4), 38);
+
+  return finish_frame(data, bits.size());
+}
+
+uint16_t msm_encoder::station_id() const
+{
+  return m_station_id;
+}
+
+void msm_encoder::station_id(uint16_t station_id)
+{
+  m_station_id = station_id;
+}
+
+void msm_encoder::reset()
+{
+  m_phase.clear();
+}
+
+} // namespace rtcm
+
+} // namespace cracl
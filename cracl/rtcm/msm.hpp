@@ -0,0 +1,170 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_RTCM_MSM_HPP
+#define CRACL_RTCM_MSM_HPP
+
+#include "frame.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace cracl
+{
+
+namespace rtcm
+{
+
+/* @brief One signal of a raw measurement epoch, using the UBX RXM-RAWX field
+ *        names and units
+ */
+struct observation
+{
+  uint8_t gnssId;
+  uint8_t svId;
+  uint8_t sigId;
+  uint8_t freqId;
+
+  double prMes;
+  double cpMes;
+  float doMes;
+
+  uint16_t locktime;
+
+  uint8_t cno;
+  uint8_t trkStat;
+};
+
+/* @brief Encodes raw measurement epochs as RTCM3 MSM4 or MSM7 messages for
+ *        GPS, GLONASS, Galileo and BeiDou, and the station position as 1005
+ *
+ * Messages are written as complete frames straight into a caller provided
+ * buffer. Carrier phase is shifted by a whole number of cycles per signal so
+ * that it stays close to the pseudorange, as MSM requires. The shift is kept
+ * while the receiver holds lock, and the reported lock time restarts
+ * whenever the shift has to change.
+ *
+ * Signals without an MSM mapping (e.g. L1C, B1C) are skipped.
+ */
+class msm_encoder
+{
+public:
+  enum type { msm4 = 4, msm7 = 7 };
+
+private:
+  // Observation converted to MSM units, signal 0 if not encoded
+  struct cell
+  {
+    uint8_t signal;
+
+    double range;
+    double phase;
+    double rate;
+
+    uint32_t lock;
+    bool half_cycle;
+  };
+
+  struct phase_state
+  {
+    int64_t offset;
+    uint16_t locktime;
+    uint16_t anchor;
+    bool valid;
+  };
+
+  uint16_t m_station_id;
+  type m_type;
+
+  double m_rcvTow;
+  int8_t m_leapS;
+
+  size_t m_count;
+  std::array<observation, 255> m_observations;
+  std::array<cell, 255> m_cells;
+
+  // Whole cycle phase shift per signal, keyed by gnssId, svId and sigId
+  std::map<uint32_t, phase_state> m_phase;
+
+  size_t encode_message(size_t system, uint64_t sat_mask, uint32_t sig_mask,
+      bool more, uint8_t* data, size_t capacity);
+
+public:
+  msm_encoder(uint16_t station_id=0, type msm=msm7);
+
+  /* @brief Encode an RXM-RAWX epoch, from ubx::rxm::rawx or rawx_view
+   *
+   * @return Number of bytes written (one or more frames per constellation)
+   */
+  template <typename Rawx>
+  size_t encode(Rawx& rawx, uint8_t* data, size_t capacity)
+  {
+    m_rcvTow = rawx.rcvTow();
+    m_leapS = rawx.leapS();
+
+    m_count = 0;
+
+    for (size_t i = 0; i < rawx.numMeas() && i < m_observations.size(); ++i)
+    {
+      observation& obs = m_observations[m_count++];
+
+      obs.gnssId = rawx.gnssId(i);
+      obs.svId = rawx.svId(i);
+      obs.sigId = rawx.sigId(i);
+      obs.freqId = rawx.freqId(i);
+      obs.prMes = rawx.prMes(i);
+      obs.cpMes = rawx.cpMes(i);
+      obs.doMes = rawx.doMes(i);
+      obs.locktime = rawx.locktime(i);
+      obs.cno = rawx.cno(i);
+      obs.trkStat = rawx.trkStat(i);
+    }
+
+    return encode(data, capacity);
+  }
+
+  /* @brief Encode the most recently loaded epoch again
+   */
+  size_t encode(uint8_t* data, size_t capacity);
+
+  /* @brief Encode message 1005 (stationary reference station ARP)
+   *
+   * @param x,y,z ECEF position in meters
+   */
+  size_t encode_station(double x, double y, double z, uint8_t* data,
+      size_t capacity) const;
+
+  uint16_t station_id() const;
+
+  void station_id(uint16_t station_id);
+
+  /* @brief Forget the phase shifts, e.g. after a receiver reset
+   */
+  void reset();
+
+};
+
+} // namespace rtcm
+
+} // namespace cracl
+
+#endif // CRACL_RTCM_MSM_HPP
@@ -21,12 +21,20 @@
 #include "base.hpp"
 
 #include "../base/device.hpp"
+#include "../base/nmea.hpp"
 
+#include <array>
+#include <chrono>
 #include <cstring>
 #include <deque>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace cracl
@@ -38,7 +46,9 @@ ublox_base::ublox_base(const std::string& location, size_t baud_rate,
     port_base::flow_control::type flow_control,
     port_base::stop_bits::type stop_bits)
   : device (location, baud_rate, timeout, char_size, std::string(delim),
-    max_handlers, parity, flow_control, stop_bits)
+    max_handlers, parity, flow_control, stop_bits), m_assemble_epochs (false),
+  m_serve_nmea (false), m_serve_rtcm (false), m_epoch_started (false),
+  m_epoch_iTOW (0), m_pps_paired (0), m_alive (std::make_shared<bool>(true))
 { }
 
 void ublox_base::buffer_messages()
@@ -55,19 +65,21 @@ void ublox_base::buffer_messages()
     {
       message.push_back(m_current);
 
-      while (message.size() < 80 // 82  - Max NMEA length (4: $<content>*##<LF>)
+      // Room is left for the two checksum characters
+      const size_t cap = nmea::tokenizer::max_length - 2;
+
+      while (message.size() < cap // Longest sentence the parsers accept
           && m_current >= 0x20   // ' ' - Min valid char
           && m_current <= 0x7e   // ~   - Max valid char
           && m_current != 0x2a)  // *   - Start of NMEA/PUBX checksum
         message.push_back(m_current = read_byte());
 
-      if (message.size() == 80)  // Read too many chars without finding checksum
-        continue;                //   implying incorrect alignment, jump out
-      else if (m_current == 0x00)// Invalid char, also port is empty, jump out
-        continue;                //   will also fail while condition and exit
-      else if (m_current < 0x20  // Invalid char, jump out and read again to
-          || m_current > 0x7e)   //   see if some start byte is recognized
+      if (m_current != 0x2a)     // Read too many chars without finding the
+      {                          //   checksum, or hit an invalid char or an
+        message.clear();         //   empty port: jump out and read again to
+                                 //   see if some start byte is recognized
         continue;
+      }
       // else: Parsed reasonable number of potentially valid characters, and
       //   found what looks like the start of a checksum field. Read two bytes
       //   for the checksum and one byte for the line ending
@@ -76,10 +88,31 @@ void ublox_base::buffer_messages()
       message.push_back(read_byte()); // Second checksum byte
       read_byte();                    // <LF> - just throw it away
 
+      if (m_shm)
+        m_shm->publish(shm::nmea, message.data(), message.size());
+
+      if (m_server && m_serve_nmea)
+      {
+        // Restore the line ending dropped above
+        std::array<uint8_t, nmea::tokenizer::max_length + 2> line;
+
+        std::memcpy(line.data(), message.data(), message.size());
+        line[message.size()] = '\r';
+        line[message.size() + 1] = '\n';
+
+        m_server->publish(line.data(), message.size() + 2);
+      }
+
       m_nmea_buffer.push_back(message);
     }
     else if (m_current == 0xb5)  // μ - Start of UBX message
     {
+      // Host time the frame started arriving, for consumers that need it
+      const auto arrival = std::chrono::system_clock::now();
+
+      // The same instant on the clock epoch timeouts are measured with
+      const auto epoch_arrival = std::chrono::steady_clock::now();
+
       message.push_back(m_current);
 
       // Read one byte, expected to be second byte of UBX header
@@ -99,7 +132,7 @@ void ublox_base::buffer_messages()
       message.push_back(read_byte());
 
       // Interpret length from bytes fetched so far
-      uint16_t length = *(reinterpret_cast<uint16_t *> (&message[4])) + 2;
+      uint16_t length = ubx::field<uint16_t>(message, 4) + 2;
 
       if (length > 4096)        // If length is absurdly large assume it's
         continue;               //   incorrect, jump out
@@ -110,7 +143,94 @@ void ublox_base::buffer_messages()
       for (size_t i = 0; i < length; ++i)
         message.push_back(read_byte());
 
-      m_ubx_buffer.push_back(message);
+      // Checked once here, every consumer below only wants intact frames
+      const bool valid = ubx::valid_checksum(message);
+
+      if (!m_latest.empty())
+        m_latest.update(message, valid);
+
+      if (m_ubx_ring)
+        m_ubx_ring->publish(message.data(), message.size(), arrival);
+
+      if (m_shm)
+      {
+        m_shm->publish(shm::ubx, message.data(), message.size(), arrival);
+
+        if (valid)
+          m_shm->update_latest(message.data(), message.size(), arrival);
+      }
+
+      if (valid)
+      {
+        // The first frame of each epoch has the least delay after the epoch
+        uint32_t iTOW;
+
+        if (ubx::epoch_assembler::time_of(message, iTOW)
+            && (!m_epoch_started || iTOW != m_epoch_iTOW))
+        {
+          m_epoch_iTOW = iTOW;
+          m_epoch_arrival = arrival;
+          m_epoch_started = true;
+        }
+
+        ubx::instant time;
+
+        if (m_timescale.convert(message, time))
+          timeutc_sample(message, time);
+
+        if (m_pps)
+          timepulse_sample(message, arrival);
+
+        if (m_time_marks)
+          time_mark_sample(message, arrival);
+      }
+
+      if (m_server && (m_served_ubx.empty() || m_served_ubx.count(
+              static_cast<uint16_t>(message[2] << 8 | message[3]))))
+        m_server->publish(message.data(), message.size());
+
+      const bool assembled = valid && m_assemble_epochs
+        && m_epochs.add(message, epoch_arrival);
+
+      if (!assembled)
+        m_ubx_buffer.push_back(message);
+    }
+    else if (m_current == rtcm::preamble) // Start of RTCM3 frame
+    {
+      message.push_back(m_current);
+
+      // Read one byte, expected to be reserved bits and top of the length
+      m_current = read_byte();
+
+      if ((m_current & 0xfc) != 0) // Reserved bits set, alignment must not be
+      {                            //   correct, jump out and check whether
+        message.clear();           //   this byte starts a message
+
+        continue;
+      }
+
+      message.push_back(m_current);
+      message.push_back(read_byte());
+
+      size_t length = rtcm::payload_length(message.data()) + rtcm::crc_size;
+
+      message.reserve(rtcm::header_size + length);
+
+      for (size_t i = 0; i < length; ++i)
+        message.push_back(read_byte());
+
+      // Unlike UBX the CRC is checked here, since 0xD3 is a common byte and
+      //   misaligned frames would otherwise be queued
+      if (rtcm::valid(message))
+      {
+        if (m_shm)
+          m_shm->publish(shm::rtcm, message.data(), message.size());
+
+        if (m_server && m_serve_rtcm)
+          m_server->publish(message.data(), message.size());
+
+        m_rtcm_buffer.push_back(message);
+      }
     }
 
     message.clear();
@@ -129,6 +249,11 @@ size_t ublox_base::ubx_queued()
   return m_ubx_buffer.size();
 }
 
+size_t ublox_base::rtcm_queued()
+{
+  return m_rtcm_buffer.size();
+}
+
 std::vector<uint8_t> ublox_base::fetch_nmea()
 {
   if (m_nmea_buffer.empty())
@@ -153,6 +278,319 @@ std::vector<uint8_t> ublox_base::fetch_ubx()
   return temp;
 }
 
+std::vector<uint8_t> ublox_base::fetch_rtcm()
+{
+  if (m_rtcm_buffer.empty())
+    buffer_messages();
+
+  std::vector<uint8_t> temp;
+
+  if (!m_rtcm_buffer.empty())
+  {
+    temp = std::move(m_rtcm_buffer.front());
+
+    m_rtcm_buffer.pop_front();
+  }
+
+  return temp;
+}
+
+std::vector<uint8_t> ublox_base::fetch_rtcm(uint16_t number, bool first_try)
+{
+  std::vector<uint8_t> temp;
+
+  if (m_rtcm_buffer.empty())
+    buffer_messages();
+
+  for (auto it = m_rtcm_buffer.begin(); it != m_rtcm_buffer.end(); ++it)
+    if (rtcm::message_number(*it) == number)
+    {
+      temp = std::move(*it);
+
+      m_rtcm_buffer.erase(it);
+
+      return temp;
+    }
+
+  // If not found and first try, double check for new frames
+  if (first_try)
+  {
+    buffer_messages();
+
+    return fetch_rtcm(number, false);
+  }
+
+  return temp;
+}
+
+const ubx::latest_value& ublox_base::track_latest(std::string&& msg_class,
+    std::string&& msg_id, size_t capacity)
+{
+  const auto& cls = ubx::msg_map.at(msg_class);
+
+  return m_latest.track(cls.first, cls.second.at(msg_id), capacity);
+}
+
+broadcast& ublox_base::broadcast_ubx(size_t slots, size_t slot_size)
+{
+  if (!m_ubx_ring)
+    m_ubx_ring.reset(new broadcast(slots, slot_size));
+
+  return *m_ubx_ring;
+}
+
+shm::publisher& ublox_base::share(const std::string& name,
+    const std::vector<std::pair<std::string, std::string>>& latest,
+    size_t slots, size_t slot_size)
+{
+  std::vector<std::pair<uint8_t, uint8_t>> types;
+
+  for (const auto& type : latest)
+  {
+    const auto& cls = ubx::msg_map.at(type.first);
+
+    types.emplace_back(cls.first, cls.second.at(type.second));
+  }
+
+  // Remove the old object first, the new one may have the same name
+  m_shm.reset();
+  m_shm.reset(new shm::publisher(name, slots, slot_size, types));
+
+  return *m_shm;
+}
+
+stream_server& ublox_base::serve(unsigned short port,
+    const std::vector<std::pair<std::string, std::string>>& ubx_types,
+    bool nmea, bool rtcm, size_t max_lag, const std::string& address)
+{
+  m_served_ubx.clear();
+
+  for (const auto& type : ubx_types)
+  {
+    const auto& cls = ubx::msg_map.at(type.first);
+
+    m_served_ubx.insert(static_cast<uint16_t>(cls.first << 8
+          | cls.second.at(type.second)));
+  }
+
+  m_serve_nmea = nmea;
+  m_serve_rtcm = rtcm;
+
+  // Release the port first, the new server may listen on the same one
+  m_server.reset();
+  m_server.reset(new stream_server(port, address, max_lag));
+
+  return *m_server;
+}
+
+ntp::shm_refclock& ublox_base::ntp_refclock(int unit, int precision)
+{
+  m_refclock.reset();
+  m_refclock.reset(new ntp::shm_refclock(unit, precision));
+
+  return *m_refclock;
+}
+
+void ublox_base::timeutc_sample(std::vector<uint8_t>& message,
+    const ubx::instant& time)
+{
+  static const auto& nav = ubx::msg_map.at("NAV");
+  static const uint8_t nav_timeutc = nav.second.at("TIMEUTC");
+
+  if (message[3] != nav_timeutc || message[2] != nav.first)
+    return;
+
+  ubx::nav::timeutc_view utc(message);
+
+  // Only a fully resolved time is of any use
+  if (!time.utc_valid || !m_epoch_started || utc.iTOW() != m_epoch_iTOW)
+    return;
+
+  const auto reference = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::nanoseconds(time.utc)));
+
+  m_host_clock.add(reference, m_epoch_arrival);
+
+  if (m_refclock)
+  {
+    // Warn of a leap second taking effect within the day
+    const int change = time.gps_valid
+      ? m_timescale.pending_change(time.gps) : 0;
+
+    m_refclock->leap(change > 0 ? ntp::insert_second
+        : change < 0 ? ntp::delete_second : ntp::no_warning);
+
+    m_refclock->sample(reference, m_epoch_arrival);
+  }
+
+  // The pulse marks the top of the second (the default TP setup), only
+  //   epochs on one can be paired with it
+  if (!m_pps || utc.nano() < -1000000 || utc.nano() > 1000000)
+    return;
+
+  pps::edge pulse;
+
+  if (!m_pps->assert_before(m_epoch_arrival, pulse)
+      || pulse.sequence == m_pps_paired)
+    return;
+
+  m_pps_paired = pulse.sequence;
+
+  pps::sample paired;
+
+  paired.pulse = pulse;
+  paired.reference = std::chrono::system_clock::time_point(
+      std::chrono::seconds((time.utc + 500000000) / 1000000000));
+
+  m_pps_samples.push_back(paired);
+
+  if (m_pps_samples.size() > 64)
+    m_pps_samples.pop_front();
+}
+
+offset_estimator& ublox_base::host_clock()
+{
+  return m_host_clock;
+}
+
+const ubx::timescale& ublox_base::timescale()
+{
+  return m_timescale;
+}
+
+pps::monitor& ublox_base::monitor_pps(int lines, bool assert_high)
+{
+  m_pps.reset();
+  m_pps_line.reset();
+
+  m_pps_line.reset(new pps::modem_line_source(location(), lines));
+  m_pps.reset(new pps::monitor(*m_pps_line, assert_high));
+
+  m_pps_samples.clear();
+  m_sawtooth.clear();
+  m_timepulses.clear();
+
+  return *m_pps;
+}
+
+pps::monitor& ublox_base::monitor_pps(pps::edge_source& source,
+    bool assert_high)
+{
+  m_pps.reset();
+  m_pps_line.reset();
+
+  m_pps.reset(new pps::monitor(source, assert_high));
+
+  m_pps_samples.clear();
+  m_sawtooth.clear();
+  m_timepulses.clear();
+
+  return *m_pps;
+}
+
+void ublox_base::timepulse_sample(std::vector<uint8_t>& message,
+    std::chrono::system_clock::time_point arrival)
+{
+  static const auto& tim = ubx::msg_map.at("TIM");
+  static const uint8_t tim_tp = tim.second.at("TP");
+
+  pps::edge pulse;
+  ubx::corrected_pulse result;
+
+  if (m_sawtooth.pending() && m_pps->assert_before(arrival, pulse)
+      && m_sawtooth.match(pulse, result))
+  {
+    m_timepulses.push_back(result);
+
+    if (m_timepulses.size() > 64)
+      m_timepulses.pop_front();
+  }
+
+  if (message[2] == tim.first && message[3] == tim_tp
+      && message.size() == 24)
+    m_sawtooth.announce(ubx::tim::tp_view(message), arrival);
+}
+
+bool ublox_base::fetch_pps(pps::sample& result)
+{
+  if (m_pps_samples.empty())
+    return false;
+
+  result = m_pps_samples.front();
+
+  m_pps_samples.pop_front();
+
+  return true;
+}
+
+bool ublox_base::fetch_timepulse(ubx::corrected_pulse& result)
+{
+  if (m_timepulses.empty())
+    return false;
+
+  result = m_timepulses.front();
+
+  m_timepulses.pop_front();
+
+  return true;
+}
+
+const ubx::sawtooth& ublox_base::timepulse_matcher()
+{
+  return m_sawtooth;
+}
+
+void ublox_base::time_mark_sample(std::vector<uint8_t>& message,
+    std::chrono::system_clock::time_point arrival)
+{
+  static const auto& tim = ubx::msg_map.at("TIM");
+  static const uint8_t tim_tm2 = tim.second.at("TM2");
+
+  if (message[2] == tim.first && message[3] == tim_tm2
+      && message.size() == 36)
+    m_time_marks->add(ubx::tim::tm2_view(message), m_timescale, arrival);
+}
+
+ubx::time_mark_stream& ublox_base::stream_time_marks(size_t slots)
+{
+  m_time_marks.reset(new ubx::time_mark_stream(slots));
+
+  return *m_time_marks;
+}
+
+bool ublox_base::fetch_epoch(ubx::epoch& result, size_t timeout)
+{
+  auto deadline = std::chrono::steady_clock::now()
+    + std::chrono::milliseconds(timeout);
+
+  m_assemble_epochs = true;
+
+  while (true)
+  {
+    auto now = std::chrono::steady_clock::now();
+
+    m_epochs.expire(now);
+
+    if (m_epochs.ready())
+    {
+      result = m_epochs.pop();
+
+      return true;
+    }
+
+    if (now >= deadline)
+      return false;
+
+    buffer_messages();
+  }
+}
+
+ubx::epoch_assembler& ublox_base::epochs()
+{
+  return m_epochs;
+}
+
 void ublox_base::flush_nmea()
 {
   m_nmea_buffer.clear();
@@ -163,22 +601,322 @@ void ublox_base::flush_ubx()
   m_ubx_buffer.clear();
 }
 
+void ublox_base::flush_rtcm()
+{
+  m_rtcm_buffer.clear();
+}
+
+void ublox_base::ubx_send(const ubx::encoder& batch)
+{
+  write(reinterpret_cast<const char*>(batch.data()), batch.size());
+}
+
+void ublox_base::rtcm_send(const std::vector<uint8_t>& frame)
+{
+  write(frame);
+}
+
+void ublox_base::rtcm_send(const uint8_t* data, size_t size)
+{
+  write(reinterpret_cast<const char*>(data), size);
+}
+
+size_t ublox_base::await_acks(uint8_t msg_class, uint8_t msg_id,
+    size_t count, size_t timeout)
+{
+  size_t acked = 0;
+  size_t answered = 0;
+
+  const uint8_t ack_class = ubx::msg_map.at("ACK").first;
+  const uint8_t ack_id = ubx::msg_map.at("ACK").second.at("ACK");
+
+  auto deadline = std::chrono::steady_clock::now()
+    + std::chrono::milliseconds(timeout);
+
+  while (true)
+  {
+    // Consume ACK-ACK/ACK-NAK responses referring to the requested message
+    for (auto it = m_ubx_buffer.begin();
+        it != m_ubx_buffer.end() && answered < count; )
+    {
+      if (it->size() == 10 && (*it)[2] == ack_class && (*it)[6] == msg_class
+          && (*it)[7] == msg_id && ubx::valid_checksum(*it))
+      {
+        acked += (*it)[3] == ack_id;
+        ++answered;
+
+        it = m_ubx_buffer.erase(it);
+      }
+      else
+        ++it;
+    }
+
+    if (answered == count || std::chrono::steady_clock::now() >= deadline)
+      break;
+
+    buffer_messages();
+  }
+
+  return acked;
+}
+
+ubx::poll_result ublox_base::poll_many(
+    const std::vector<std::pair<uint8_t, uint8_t>>& messages, size_t timeout)
+{
+  ubx::poll_result result;
+
+  result.messages.resize(messages.size());
+
+  if (messages.empty())
+    return result;
+
+  std::vector<uint8_t> buffer(messages.size() * ubx::frame_size<>::value);
+
+  ubx::encoder batch(buffer.data(), buffer.size());
+
+  for (const auto& msg : messages)
+    batch.add(msg.first, msg.second);
+
+  // Anything already queued was output before the polls
+  const size_t queued = m_ubx_buffer.size();
+
+  ubx_send(batch);
+
+  size_t outstanding = messages.size();
+
+  auto deadline = std::chrono::steady_clock::now()
+    + std::chrono::milliseconds(timeout);
+
+  while (true)
+  {
+    for (auto it = m_ubx_buffer.begin() + queued;
+        it != m_ubx_buffer.end() && outstanding > 0; )
+    {
+      size_t i = 0;
+
+      // Several polls of the same message are answered in order
+      while (i < messages.size() && (messages[i].first != (*it)[2]
+            || messages[i].second != (*it)[3]
+            || !result.messages[i].empty()))
+        ++i;
+
+      if (i < messages.size() && ubx::valid_checksum(*it))
+      {
+        result.messages[i] = std::move(*it);
+        --outstanding;
+
+        it = m_ubx_buffer.erase(it);
+      }
+      else
+        ++it;
+    }
+
+    if (outstanding == 0 || std::chrono::steady_clock::now() >= deadline)
+      break;
+
+    buffer_messages();
+  }
+
+  for (size_t i = 0; i < messages.size(); ++i)
+    if (result.messages[i].empty())
+      result.timed_out.push_back(i);
+
+  return result;
+}
+
+std::map<uint32_t, uint8_t> ublox_base::rate_changes(
+    std::map<uint32_t, uint8_t> desired) const
+{
+  // The most frequent output any subscriber asked for (sets sort smallest
+  //   first), unless the profile already asks for more
+  for (const auto& interest : m_subscribers)
+  {
+    const uint8_t rate = *interest.second.begin();
+    auto wanted = desired.find(interest.first);
+
+    if (wanted == desired.end() || wanted->second == 0
+        || wanted->second > rate)
+      desired[interest.first] = rate;
+  }
+
+  std::map<uint32_t, uint8_t> changes;
+
+  for (const auto& rate : desired)
+  {
+    auto current = m_rates.find(rate.first);
+
+    if (current == m_rates.end() || current->second != rate.second)
+      changes.insert(rate);
+  }
+
+  for (const auto& rate : m_rates)
+    if (rate.second != 0 && desired.find(rate.first) == desired.end())
+      changes[rate.first] = 0;
+
+  return changes;
+}
+
+std::map<uint32_t, uint8_t> ublox_base::rate_changes() const
+{
+  std::map<uint32_t, uint8_t> desired = m_requested;
+
+  desired.insert(m_found.begin(), m_found.end());
+
+  return rate_changes(desired);
+}
+
+void ublox_base::profile_applied(const std::map<uint32_t, uint8_t>& desired)
+{
+  m_requested = desired;
+
+  // The profile now decides every rate, including ones found before
+  m_found.clear();
+}
+
+bool ublox_base::rate_known(uint32_t key) const
+{
+  return m_requested.count(key) || m_rates.count(key) || m_found.count(key);
+}
+
+void ublox_base::rate_found(uint32_t key, uint8_t rate)
+{
+  m_found[key] = rate;
+}
+
+std::map<uint32_t, uint8_t> ublox_base::subscription_changes(uint32_t key,
+    uint8_t rate, bool subscribe)
+{
+  if (subscribe)
+    m_subscribers[key].insert(rate);
+  else
+  {
+    auto interest = m_subscribers.find(key);
+
+    if (interest != m_subscribers.end())
+    {
+      auto one = interest->second.find(rate);
+
+      if (one != interest->second.end())
+        interest->second.erase(one);
+
+      if (interest->second.empty())
+        m_subscribers.erase(interest);
+    }
+  }
+
+  return rate_changes();
+}
+
+void ublox_base::rates_applied(const std::map<uint32_t, uint8_t>& changes,
+    bool confirmed)
+{
+  for (const auto& rate : changes)
+  {
+    if (confirmed)
+      m_rates[rate.first] = rate.second;
+    else
+      m_rates.erase(rate.first);
+  }
+}
+
 void ublox_base::disable_nmea()
 {
   // Disable all NMEA message types (0) for all ports
   // RATE - NMEA TYPE - DDC - USART1 - USART2 - USB - SPI - reserved
-  pubx_send("RATE", "DTM", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GLL", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GNS", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GSA", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GST", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GSG", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GSV", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "GGA", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "RMC", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "VTG", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "VLW", 0, 0, 0, 0, 0, 0);
-  pubx_send("RATE", "ZDA", 0, 0, 0, 0, 0, 0);
+  const char* types[] = { "DTM", "GLL", "GNS", "GSA", "GST", "GSG", "GSV",
+    "GGA", "RMC", "VTG", "VLW", "ZDA" };
+
+  const uint8_t rate = ubx::msg_map.at("PUBX").second.at("RATE");
+
+  // Coalesce every command into a single write
+  std::array<char, sizeof (types) / sizeof (types[0]) * 82> buffer;
+  size_t size = 0;
+
+  for (const char* type : types)
+  {
+    nmea::sentence message("PUBX");
+
+    message.hex_field(rate);
+    message.fields(type, 0, 0, 0, 0, 0, 0);
+    message.finish();
+
+    std::memcpy(buffer.data() + size, message.data(), message.size());
+    size += message.size();
+  }
+
+  write(buffer.data(), size);
+}
+
+bool ublox_base::ping(size_t timeout)
+{
+  const auto& mon = ubx::msg_map.at("MON");
+  const uint8_t mon_ver = mon.second.at("VER");
+
+  ubx::static_encoder<ubx::frame_size<>::value> poll;
+
+  poll.add(mon.first, mon_ver);
+
+  auto now = std::chrono::steady_clock::now();
+  auto deadline = now + std::chrono::milliseconds(timeout);
+  auto next_poll = now;
+
+  do
+  {
+    // Poll again periodically, an earlier poll may have been lost while the
+    //   link was changing
+    if (now >= next_poll)
+    {
+      ubx_send(poll);
+
+      next_poll = now + std::chrono::milliseconds(250);
+    }
+
+    buffer_messages();
+
+    for (auto it = m_ubx_buffer.begin(); it != m_ubx_buffer.end(); ++it)
+      if ((*it)[2] == mon.first && (*it)[3] == mon_ver
+          && ubx::valid_checksum(*it))
+      {
+        m_ubx_buffer.erase(it);
+
+        return true;
+      }
+  }
+  while ((now = std::chrono::steady_clock::now()) < deadline);
+
+  return false;
+}
+
+bool ublox_base::follow_baud_rate(size_t rate, size_t timeout)
+{
+  const size_t previous = baud_rate();
+
+  // Let the configuration command leave the host and give the receiver time
+  //   to apply it before switching
+  drain();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  baud_rate(rate);
+
+  if (ping(timeout))
+    return true;
+
+  // Still answering at the old rate means the change was rejected
+  baud_rate(previous);
+
+  if (ping(timeout))
+    return false;
+
+  // Neither rate answered the first time round, the receiver may just have
+  //   been slow to switch
+  baud_rate(rate);
+
+  if (ping(timeout))
+    return true;
+
+  throw std::runtime_error("Receiver unreachable at " + std::to_string(rate)
+      + " or " + std::to_string(previous) + " baud");
 }
 
 } // namespace cracl
@@ -21,12 +21,34 @@
 #ifndef CRACL_UBLOX_BASE_HPP
 #define CRACL_UBLOX_BASE_HPP
 
+#include "epoch.hpp"
+#include "latest.hpp"
+#include "poll.hpp"
+#include "sawtooth.hpp"
+#include "subscription.hpp"
+#include "time_mark.hpp"
+#include "timescale.hpp"
 #include "msg/base.hpp"
+#include "msg/class/nav.hpp"
+#include "msg/encoder.hpp"
+#include "../base/broadcast.hpp"
 #include "../base/device.hpp"
-
+#include "../base/nmea.hpp"
+#include "../base/ntp.hpp"
+#include "../base/offset_estimator.hpp"
+#include "../base/pps.hpp"
+#include "../base/server.hpp"
+#include "../base/shm.hpp"
+#include "../rtcm/frame.hpp"
+
+#include <chrono>
 #include <deque>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cracl
@@ -37,65 +59,135 @@ class ublox_base : public device
 protected:
   std::deque<std::vector<uint8_t>> m_ubx_buffer;
   std::deque<std::vector<uint8_t>> m_nmea_buffer;
-
-  size_t payload_size()
-  {
-    return 0;
-  }
-
-  template <typename T>
-  size_t payload_size(T t)
-  {
-    return sizeof (T);
-  }
-
-  template <typename T, typename... Args>
-  size_t payload_size(T t, Args... args)
-  {
-    return sizeof (T) + payload_size(args...);
-  }
-
-private:
-  void add_pubx_payload(std::vector<char> &message) { }
-
-  template <typename... Args>
-  void add_pubx_payload(std::vector<char> &message, const char* t, Args... args)
-  {
-    message.push_back(',');
-
-    for (const char* ch = t; *ch != 0x00; ++ch)
-      message.push_back(*ch);
-
-    add_pubx_payload(message, args...);
-  }
-
-  template <typename T, typename... Args>
-  void add_pubx_payload(std::vector<char> &message, T t, Args... args)
-  {
-    auto temp = std::to_string(t);
-
-    message.push_back(',');
-
-    for (auto const& ch : temp)
-      message.push_back(ch);
-
-    add_pubx_payload(message, args...);
-  }
-
-protected:
-  void add_ubx_payload(std::vector<uint8_t> &message) { }
-
-  template <typename T, typename... Args>
-  void add_ubx_payload(std::vector<uint8_t> &message, T t, Args... args)
-  {
-    uint8_t *x = reinterpret_cast<uint8_t *>(&t);
-
-    // For little endian systems, reverse loop for big endian
-    for (size_t i = 0; i < sizeof (T); ++i)
-      message.push_back(x[i]);
-
-    add_ubx_payload(message, args...);
-  }
+  std::deque<std::vector<uint8_t>> m_rtcm_buffer;
+
+  // Fed by the framer once fetch_epoch has been called
+  ubx::epoch_assembler m_epochs;
+  bool m_assemble_epochs;
+
+  ubx::latest_cache m_latest;
+
+  std::unique_ptr<broadcast> m_ubx_ring;
+
+  std::unique_ptr<shm::publisher> m_shm;
+
+  // Frames forwarded to TCP clients, UBX by class and ID (empty for all)
+  std::unique_ptr<stream_server> m_server;
+  std::set<uint16_t> m_served_ubx;
+  bool m_serve_nmea;
+  bool m_serve_rtcm;
+
+  std::unique_ptr<ntp::shm_refclock> m_refclock;
+
+  offset_estimator m_host_clock;
+
+  // Epoch of the latest frame carrying one, and when its first frame began
+  //   arriving
+  bool m_epoch_started;
+  uint32_t m_epoch_iTOW;
+  std::chrono::system_clock::time_point m_epoch_arrival;
+
+  // Leap seconds and offsets learned from every NAV-TIME* frame
+  ubx::timescale m_timescale;
+
+  /* @brief If a frame is a NAV-TIMEUTC with a fully valid UTC time, pair the
+   *        time with the arrival of the epoch's first frame and pass it to
+   *        the host clock estimator and NTP refclock
+   */
+  void timeutc_sample(std::vector<uint8_t>& message,
+      const ubx::instant& time);
+
+  // PPS edges, the monitor is declared after its source so it stops first
+  std::unique_ptr<pps::edge_source> m_pps_line;
+  std::unique_ptr<pps::monitor> m_pps;
+  std::deque<pps::sample> m_pps_samples;
+  uint64_t m_pps_paired;
+
+  // TIM-TP held for its pulse, and the corrected pulses
+  ubx::sawtooth m_sawtooth;
+  std::deque<ubx::corrected_pulse> m_timepulses;
+
+  /* @brief Hold each TIM-TP and match the held one against the latest PPS
+   *        edge as frames arrive. Frames must have a valid checksum
+   */
+  void timepulse_sample(std::vector<uint8_t>& message,
+      std::chrono::system_clock::time_point arrival);
+
+  std::unique_ptr<ubx::time_mark_stream> m_time_marks;
+
+  /* @brief Publish each TIM-TM2 to the time mark stream. Frames must have a
+   *        valid checksum
+   */
+  void time_mark_sample(std::vector<uint8_t>& message,
+      std::chrono::system_clock::time_point arrival);
+
+  // Last output rate confirmed by the receiver, keyed by a device specific
+  //   message identifier
+  std::map<uint32_t, uint8_t> m_rates;
+
+  // Rates asked for by the last profile applied, and by each subscriber
+  std::map<uint32_t, uint8_t> m_requested;
+  std::map<uint32_t, std::multiset<uint8_t>> m_subscribers;
+
+  // Rates found on the receiver before a message's first subscriber, for
+  //   messages the last profile doesn't set. Restored once the last
+  //   subscriber leaves, and forgotten when the next profile is applied
+  std::map<uint32_t, uint8_t> m_found;
+
+  // Watched weakly by subscription handles, so a handle released after the
+  //   receiver is destroyed does nothing
+  std::shared_ptr<bool> m_alive;
+
+  /* @brief Determine the rate commands needed to move from the confirmed
+   *        rates to a desired set, with subscribed messages output at least
+   *        as often as their subscribers need. Messages previously enabled
+   *        but missing from both are disabled
+   */
+  std::map<uint32_t, uint8_t> rate_changes(
+      std::map<uint32_t, uint8_t> desired) const;
+
+  /* @brief As above, for the last profile applied and the rates found
+   */
+  std::map<uint32_t, uint8_t> rate_changes() const;
+
+  /* @brief Make a profile the one rates return to, once the receiver has
+   *        confirmed its changes. Rates found before are forgotten
+   */
+  void profile_applied(const std::map<uint32_t, uint8_t>& desired);
+
+  /* @brief True if the rate a message returns to without subscribers is
+   *        known, i.e. set by the last profile, by this object, or found
+   */
+  bool rate_known(uint32_t key) const;
+
+  /* @brief Record the rate a message was output at before it was subscribed
+   *        to, so it is restored after the last subscriber
+   */
+  void rate_found(uint32_t key, uint8_t rate);
+
+  /* @brief Add or remove one subscriber's interest in a message, returning
+   *        the rate commands needed
+   */
+  std::map<uint32_t, uint8_t> subscription_changes(uint32_t key, uint8_t rate,
+      bool subscribe);
+
+  /* @brief Record the outcome of sending a set of rate changes. Unconfirmed
+   *        changes are forgotten so that they are sent again next time
+   */
+  void rates_applied(const std::map<uint32_t, uint8_t>& changes,
+      bool confirmed);
+
+  /* @brief Switch the host port to the rate the receiver was just told
+   *        to use, then confirm the link with a poll. If the receiver does
+   *        not answer, the host returns to the previous rate, and if it
+   *        doesn't answer there either the new rate is tried once more
+   *
+   * @return True if the receiver answered at the new rate, false if it
+   *         answered at the previous rate (the change was rejected)
+   *
+   * Throws if the receiver answers at neither rate
+   */
+  bool follow_baud_rate(size_t rate, size_t timeout);
 
 public:
   ublox_base(const std::string& location, size_t baud_rate=9600,
@@ -111,6 +203,8 @@ public:
 
   size_t ubx_queued();
 
+  size_t rtcm_queued();
+
   std::vector<uint8_t> fetch_nmea();
 
   std::vector<uint8_t> fetch_ubx();
@@ -118,51 +212,204 @@ public:
   std::vector<uint8_t> fetch_ubx(std::string&& msg_class,
       std::string&& msg_id, bool first_try=true);
 
+  /* @brief Fetch the oldest RTCM3 frame (CRC already verified), empty if
+   *        none has been received. Use rtcm::message_number() to identify it
+   */
+  std::vector<uint8_t> fetch_rtcm();
+
+  /* @brief Fetch the oldest RTCM3 frame with a given message number
+   */
+  std::vector<uint8_t> fetch_rtcm(uint16_t number, bool first_try=true);
+
+  /* @brief Have the framer keep the most recent frame of a message type,
+   *        readable from any thread without locking (e.g. NAV-TIMEUTC or
+   *        MON-HW state). Frames are still queued for fetch_ubx as usual.
+   *        Call before threads reading the value start
+   *
+   * @param capacity Largest frame kept, in bytes including framing
+   */
+  const ubx::latest_value& track_latest(std::string&& msg_class,
+      std::string&& msg_id, size_t capacity=256);
+
+  /* @brief Have the framer also publish every UBX frame, with its arrival
+   *        time, to a ring that any number of consumers can read with their
+   *        own cursors. Call before other threads subscribe; calling again
+   *        returns the existing ring
+   *
+   * @param slots Number of frames held for slow consumers
+   * @param slot_size Largest frame published, in bytes
+   */
+  broadcast& broadcast_ubx(size_t slots=256, size_t slot_size=2048);
+
+  /* @brief Publish every UBX, NMEA and RTCM3 frame received to other
+   *        processes through a shared memory object, read with shm::reader.
+   *        Replaces any object shared before
+   *
+   * @param latest UBX messages (class and ID names) whose latest values are
+   *        also kept, e.g. {{"NAV", "TIMEUTC"}, {"MON", "HW"}}
+   */
+  shm::publisher& share(const std::string& name,
+      const std::vector<std::pair<std::string, std::string>>& latest={},
+      size_t slots=1024, size_t slot_size=2048);
+
+  /* @brief Stream received frames, as they arrived on the port, to TCP
+   *        clients (e.g. RTKLIB or gpsd) served from a background thread.
+   *        Replaces any server started before
+   *
+   * @param ubx_types UBX messages (class and ID names) to forward, empty to
+   *        forward every UBX message
+   * @param nmea Forward NMEA sentences
+   * @param rtcm Forward RTCM3 frames
+   * @param max_lag Most bytes a client may fall behind before it is
+   *        disconnected
+   * @param address Address to listen on, e.g. "0.0.0.0" to serve the LAN
+   */
+  stream_server& serve(unsigned short port,
+      const std::vector<std::pair<std::string, std::string>>& ubx_types={},
+      bool nmea=true, bool rtcm=true, size_t max_lag=262144,
+      const std::string& address="127.0.0.1");
+
+  /* @brief Feed NTP (ntpd or chrony) from NAV-TIMEUTC through an SHM
+   *        refclock segment, updated by the framer as each message arrives.
+   *        Samples are timestamped with the arrival of the first frame of
+   *        the epoch, the serial delay after the epoch remains and is best
+   *        removed with the daemon's offset option. Replaces any refclock set
+   *        up before
+   *
+   * @param unit SHM unit, i.e. "refclock SHM <unit>"
+   * @param precision Sample precision as a power of 2 in seconds
+   */
+  ntp::shm_refclock& ntp_refclock(int unit=0, int precision=-7);
+
+  /* @brief Estimate of the host clock against the receiver's UTC, updated
+   *        by the framer from each valid NAV-TIMEUTC and the arrival of the
+   *        first frame of its epoch
+   */
+  offset_estimator& host_clock();
+
+  /* @brief Leap second state learned by the framer from NAV-TIMEGPS,
+   *        TIMEGAL, TIMEBDS and TIMELS, for converting other times
+   */
+  const ubx::timescale& timescale();
+
+  /* @brief Timestamp PPS edges on a modem-control line of this port from a
+   *        thread of their own. Each top-of-second NAV-TIMEUTC is paired
+   *        with the assert edge that preceded its epoch, see fetch_pps.
+   *        Needs a serial port that reports modem line changes (most USB
+   *        adapters don't)
+   *
+   * @param lines Modem lines carrying PPS, 0 for DCD
+   * @param assert_high True if the pulse is asserted by a rising edge
+   */
+  pps::monitor& monitor_pps(int lines=0, bool assert_high=true);
+
+  /* @brief As above, with edges from another source, e.g. an
+   *        pps::injected_source. The source must outlive this object or the
+   *        next call to monitor_pps
+   */
+  pps::monitor& monitor_pps(pps::edge_source& source, bool assert_high=true);
+
+  /* @brief Take the oldest PPS edge paired with the UTC second it marks
+   *
+   * @return False if no paired edge is waiting
+   */
+  bool fetch_pps(pps::sample& result);
+
+  /* @brief Take the oldest PPS edge corrected with the quantization error
+   *        from its TIM-TP (TIM-TP must be enabled and monitor_pps running).
+   *        Available once the first frame after the pulse has been read
+   *
+   * @return False if no corrected edge is waiting
+   */
+  bool fetch_timepulse(ubx::corrected_pulse& result);
+
+  /* @brief The matching stage behind fetch_timepulse, for its counters
+   */
+  const ubx::sawtooth& timepulse_matcher();
+
+  /* @brief Publish TIM-TM2 external event marks to readers as they're
+   *        framed, decoded to nanoseconds. UTC times of marks on the GNSS
+   *        time base need the leap seconds (e.g. NAV-TIMEGPS or NAV-TIMELS
+   *        enabled). Replaces
+   *        any stream set up before
+   *
+   * @param slots Marks held for readers that fall behind
+   */
+  ubx::time_mark_stream& stream_time_marks(size_t slots=1024);
+
+  /* @brief Wait for the next navigation epoch. From the first call on,
+   *        messages belonging to an epoch are assembled as they are framed
+   *        instead of being queued, anything else is left for fetch_ubx
+   *
+   * @param timeout Time in milliseconds to wait for an epoch to close
+   *
+   * @return False if no epoch closed before the timeout
+   */
+  bool fetch_epoch(ubx::epoch& result, size_t timeout=2000);
+
+  /* @brief Assembler used by fetch_epoch, e.g. to adjust its timeout or read
+   *        its counters
+   */
+  ubx::epoch_assembler& epochs();
+
   void flush_nmea();
 
   void flush_ubx();
 
+  void flush_rtcm();
+
+  /* @brief Write every frame held by an encoder to the port in a single write
+   */
+  void ubx_send(const ubx::encoder& batch);
+
+  /* @brief Write a complete RTCM3 frame (e.g. corrections for a rover)
+   */
+  void rtcm_send(const std::vector<uint8_t>& frame);
+
+  void rtcm_send(const uint8_t* data, size_t size);
+
+  /* @brief Wait for the receiver to acknowledge count messages of the given
+   *        class and ID, consuming the matching ACK-ACK/ACK-NAK responses
+   *
+   * @param timeout Time in milliseconds to wait for all responses
+   *
+   * @return Number of messages acknowledged with ACK-ACK
+   */
+  size_t await_acks(uint8_t msg_class, uint8_t msg_id, size_t count,
+      size_t timeout);
+
+  /* @brief Poll several messages, by class and ID, in a single write and
+   *        collect the responses from the framer as they arrive. Only frames
+   *        framed after the write count as responses
+   *
+   * @param timeout Time in milliseconds to wait for all responses
+   */
+  ubx::poll_result poll_many(
+      const std::vector<std::pair<uint8_t, uint8_t>>& messages,
+      size_t timeout=1000);
+
   template <typename... Args>
   void pubx_send(std::string&& msg_id, Args... args)
   {
-    uint8_t checksum = 0x00;
-    std::vector<char> message = { '$', 'P', 'U', 'B', 'X', ',' };
+    nmea::sentence message("PUBX");
 
-    uint8_t a = (ubx::msg_map.at("PUBX").second.at(msg_id) & 0xf0) >> 4;
-    uint8_t b = ubx::msg_map.at("PUBX").second.at(msg_id) & 0x0f;
+    message.hex_field(ubx::msg_map.at("PUBX").second.at(msg_id));
+    message.fields(args...);
+    message.finish();
 
-    a += a < 0xa ? '0' : ('A' - 0xa);
-    b += b < 0xa ? '0' : ('A' - 0xa);
-
-    message.push_back(a);
-    message.push_back(b);
-
-    add_pubx_payload(message, args...);
-
-    // Compute XOR checksum
-    for (size_t i = 1; i < message.size(); ++i)
-      checksum ^= static_cast<uint8_t>(message[i]);
-
-    a = (checksum & 0xf0) >> 4;
-    b = checksum & 0x0f;
-
-    // Convert values to plaintext hexadecimal
-    a += a < 0xa ? '0' : ('A' - 0xa);
-    b += b < 0xa ? '0' : ('A' - 0xa);
-
-    message.push_back('*');
-
-    message.push_back(a);
-    message.push_back(b);
-
-    message.push_back('\r');
-    message.push_back('\n');
-
-    write(message);
+    write(message.data(), message.size());
   }
 
   void disable_nmea();
 
+  /* @brief Poll MON-VER until the receiver answers or the timeout expires
+   *
+   * @param timeout Time in milliseconds to keep polling
+   *
+   * @return True if a valid MON-VER response was received
+   */
+  bool ping(size_t timeout=1000);
+
 };
 
 } // namespace cracl
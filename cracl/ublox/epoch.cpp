@@ -0,0 +1,275 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "epoch.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace
+{
+
+const int64_t week_ms = 604800000;
+
+// Epochs further in the past than this are taken as the receiver having been
+//   reset (or its time corrected) rather than as late messages
+const int64_t reset_window = 60000;
+
+} // namespace
+
+int64_t time_difference(uint32_t a_iTOW, int32_t a_week, uint32_t b_iTOW,
+    int32_t b_week)
+{
+  int64_t diff = static_cast<int64_t>(a_iTOW) - static_cast<int64_t>(b_iTOW);
+
+  if (a_week >= 0 && b_week >= 0)
+    return diff + (static_cast<int64_t>(a_week) - b_week) * week_ms;
+
+  if (diff > week_ms / 2)
+    diff -= week_ms;
+  else if (diff < -week_ms / 2)
+    diff += week_ms;
+
+  return diff;
+}
+
+const std::vector<uint8_t>* epoch::find(uint8_t msg_class,
+    uint8_t msg_id) const
+{
+  for (const auto& message : messages)
+    if (message[2] == msg_class && message[3] == msg_id)
+      return &message;
+
+  return nullptr;
+}
+
+epoch_assembler::epoch_assembler(size_t timeout, size_t max_pending)
+  : m_timeout (timeout), m_max_pending (max_pending == 0 ? 1 : max_pending),
+  m_delivered (false), m_last_iTOW (0), m_late (0), m_timed_out (0)
+{ }
+
+bool epoch_assembler::time_of(const std::vector<uint8_t>& message,
+    uint32_t& iTOW)
+{
+  static const auto& nav = msg_map.at("NAV");
+  static const auto& rxm = msg_map.at("RXM");
+
+  // Messages with iTOW following another field rather than first
+  static const uint8_t offset_ids[] = { nav.second.at("ODO"),
+    nav.second.at("HPPOSECEF"), nav.second.at("HPPOSLLH"),
+    nav.second.at("RELPOSNED"), nav.second.at("SVIN") };
+
+  static const uint8_t rawx = rxm.second.at("RAWX");
+
+  if (message.size() < 8)
+    return false;
+
+  const size_t length = message.size() - 8;
+
+  if (message[2] == nav.first)
+  {
+    size_t offset = 6;
+
+    for (uint8_t id : offset_ids)
+      if (message[3] == id)
+        offset += 4;
+
+    if (length + 6 < offset + 4)
+      return false;
+
+    iTOW = field<uint32_t>(message, offset);
+
+    return true;
+  }
+  else if (message[2] == rxm.first && message[3] == rawx && length >= 16)
+  {
+    // Measurement time is rounded to the solution it belongs to
+    const double rcvTow = field<double>(message, 6);
+
+    iTOW = static_cast<uint32_t>(std::llround(rcvTow * 1e3) % week_ms);
+
+    return true;
+  }
+
+  return false;
+}
+
+bool epoch_assembler::add(std::vector<uint8_t>& message,
+    epoch::clock::time_point now)
+{
+  static const auto& nav = msg_map.at("NAV");
+  static const uint8_t nav_eoe = nav.second.at("EOE");
+  static const uint8_t nav_timegps = nav.second.at("TIMEGPS");
+  static const uint8_t rxm = msg_map.at("RXM").first;
+
+  uint32_t iTOW;
+
+  if (!time_of(message, iTOW))
+    return false;
+
+  if (m_delivered)
+  {
+    const int64_t diff = time_difference(iTOW, -1, m_last_iTOW, -1);
+
+    if (diff <= 0 && diff > -reset_window)
+    {
+      ++m_late;
+
+      message.clear();
+
+      return true;
+    }
+  }
+
+  auto it = m_pending.begin();
+
+  while (it != m_pending.end() && it->iTOW != iTOW)
+    ++it;
+
+  if (message[2] == nav.first && message[3] == nav_eoe)
+  {
+    message.clear();
+
+    // Anything older is not going to be completed
+    while (!m_pending.empty()
+        && time_difference(m_pending.front().iTOW, -1, iTOW, -1) < 0)
+      close(m_pending.begin(), false);
+
+    for (it = m_pending.begin(); it != m_pending.end() && it->iTOW != iTOW;
+        ++it)
+      ;
+
+    // Nothing else arrived for the epoch (e.g. only NAV-EOE is enabled), so
+    //   there is nothing to deliver
+    if (it != m_pending.end())
+      close(it, true);
+
+    return true;
+  }
+
+  if (it == m_pending.end())
+  {
+    if (m_pending.size() == m_max_pending)
+      close(m_pending.begin(), false);
+
+    m_pending.emplace_back();
+
+    it = m_pending.end() - 1;
+
+    it->iTOW = iTOW;
+    it->week = -1;
+    it->complete = false;
+    it->arrival = now;
+  }
+
+  if (message[2] == nav.first && message[3] == nav_timegps)
+  {
+    // weekValid flag
+    if (message.size() >= 24 && (message[17] & 0x02))
+      it->week = field<int16_t>(message, 14);
+  }
+  else if (message[2] == rxm)
+    it->week = field<uint16_t>(message, 14);
+
+  it->messages.push_back(std::move(message));
+
+  message.clear();
+
+  return true;
+}
+
+void epoch_assembler::close(std::deque<epoch>::iterator it, bool complete)
+{
+  it->complete = complete;
+
+  if (!complete)
+    ++m_timed_out;
+
+  if (!m_delivered || time_difference(it->iTOW, -1, m_last_iTOW, -1) > 0)
+    m_last_iTOW = it->iTOW;
+
+  m_delivered = true;
+
+  m_ready.push_back(std::move(*it));
+
+  m_pending.erase(it);
+}
+
+void epoch_assembler::expire(epoch::clock::time_point now)
+{
+  while (!m_pending.empty() && now - m_pending.front().arrival
+      > std::chrono::milliseconds(m_timeout))
+    close(m_pending.begin(), false);
+}
+
+size_t epoch_assembler::ready() const
+{
+  return m_ready.size();
+}
+
+size_t epoch_assembler::pending() const
+{
+  return m_pending.size();
+}
+
+epoch epoch_assembler::pop()
+{
+  epoch temp = std::move(m_ready.front());
+
+  m_ready.pop_front();
+
+  return temp;
+}
+
+size_t epoch_assembler::late() const
+{
+  return m_late;
+}
+
+size_t epoch_assembler::timed_out() const
+{
+  return m_timed_out;
+}
+
+void epoch_assembler::timeout(size_t timeout)
+{
+  m_timeout = timeout;
+}
+
+void epoch_assembler::clear()
+{
+  m_pending.clear();
+  m_ready.clear();
+
+  m_delivered = false;
+}
+
+} // namespace ubx
+
+} // namespace cracl
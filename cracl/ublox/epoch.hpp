@@ -0,0 +1,146 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_EPOCH_HPP
+#define CRACL_UBLOX_EPOCH_HPP
+
+#include "msg/base.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Every navigation message (and RXM-RAWX) output for one solution
+ */
+struct epoch
+{
+  typedef std::chrono::steady_clock clock;
+
+  // GPS time of week of the solution in milliseconds
+  uint32_t iTOW;
+
+  // GPS week from NAV-TIMEGPS or RXM-RAWX, -1 if neither was received
+  int32_t week;
+
+  // True if closed by NAV-EOE, false if closed by the timeout or by a later
+  //   epoch (some messages may be missing)
+  bool complete;
+
+  // Host arrival time of the first message
+  clock::time_point arrival;
+
+  // Complete UBX frames in order of arrival (NAV-EOE is not included)
+  std::vector<std::vector<uint8_t>> messages;
+
+  /* @brief Find a message by class and ID, nullptr if not part of the epoch
+   */
+  const std::vector<uint8_t>* find(uint8_t msg_class, uint8_t msg_id) const;
+
+};
+
+/* @brief Signed difference a - b in milliseconds between two GPS times. The
+ *        week is used when both are known (non-negative), otherwise the times
+ *        are assumed to be within half a week of each other
+ */
+int64_t time_difference(uint32_t a_iTOW, int32_t a_week, uint32_t b_iTOW,
+    int32_t b_week);
+
+/* @brief Groups navigation messages by iTOW into epochs
+ *
+ * An epoch is closed when NAV-EOE for its iTOW arrives. Receivers without
+ * NAV-EOE enabled (or messages lost on the link) fall back to closing an
+ * epoch once it has been open for longer than the timeout, or once more than
+ * max_pending epochs are open. Messages arriving for an epoch that has
+ * already been delivered are dropped and counted as late.
+ */
+class epoch_assembler
+{
+  size_t m_timeout;
+  size_t m_max_pending;
+
+  std::deque<epoch> m_pending;
+  std::deque<epoch> m_ready;
+
+  bool m_delivered;
+  uint32_t m_last_iTOW;
+
+  size_t m_late;
+  size_t m_timed_out;
+
+  void close(std::deque<epoch>::iterator it, bool complete);
+
+public:
+  /* @param timeout Milliseconds an epoch may stay open without NAV-EOE
+   * @param max_pending Most epochs open at once
+   */
+  epoch_assembler(size_t timeout=1500, size_t max_pending=4);
+
+  /* @brief Time of week in milliseconds a message belongs to
+   *
+   * @return False if the message doesn't carry an epoch time
+   */
+  static bool time_of(const std::vector<uint8_t>& message, uint32_t& iTOW);
+
+  /* @brief Add a message (checksum already verified). Messages that are
+   *        part of an epoch are moved from
+   *
+   * @return False if the message isn't part of an epoch and was not taken
+   */
+  bool add(std::vector<uint8_t>& message,
+      epoch::clock::time_point now=epoch::clock::now());
+
+  /* @brief Close epochs open for longer than the timeout
+   */
+  void expire(epoch::clock::time_point now=epoch::clock::now());
+
+  size_t ready() const;
+
+  size_t pending() const;
+
+  /* @brief Oldest closed epoch, ready() must be non-zero
+   */
+  epoch pop();
+
+  /* @brief Messages dropped because their epoch was already delivered
+   */
+  size_t late() const;
+
+  /* @brief Epochs closed without NAV-EOE
+   */
+  size_t timed_out() const;
+
+  void timeout(size_t timeout);
+
+  void clear();
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_EPOCH_HPP
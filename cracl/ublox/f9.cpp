@@ -22,6 +22,14 @@
 
 #include "../base/device.hpp"
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace cracl
 {
 
@@ -66,4 +74,242 @@ std::vector<uint8_t> f9::fetch_ubx(std::string&& msg_class,
   return temp;
 }
 
+ubx::poll_result f9::poll_many(
+    const std::vector<std::pair<std::string, std::string>>& messages,
+    size_t timeout)
+{
+  std::vector<std::pair<uint8_t, uint8_t>> ids;
+
+  ids.reserve(messages.size());
+
+  for (const auto& name : messages)
+  {
+    const auto& msg = ubx::f9_map.at(name.first);
+
+    ids.emplace_back(msg.first, msg.second.at(name.second));
+  }
+
+  return poll_many(ids, timeout);
+}
+
+bool f9::apply_rates(const ubx::rate_profile& profile, ubx::port_id port,
+    size_t timeout)
+{
+  std::map<uint32_t, uint8_t> desired;
+
+  // Key each message by its CFG-MSGOUT key ID for the requested port
+  for (const auto& msg_class : profile)
+  {
+    const auto& keys = ubx::f9_msgout_map.at(msg_class.first);
+
+    for (const auto& msg_id : msg_class.second)
+      desired[keys.at(msg_id.first) + port] = msg_id.second;
+  }
+
+  if (!send_rates(rate_changes(desired), timeout))
+    return false;
+
+  // A rejected profile leaves the last one in place
+  profile_applied(desired);
+
+  return true;
+}
+
+ubx::subscription f9::subscribe(const std::string& msg_class,
+    const std::string& msg_id, uint8_t rate, ubx::port_id port,
+    size_t timeout)
+{
+  if (rate == 0)
+    throw std::runtime_error("Subscription rate must be at least 1");
+
+  const uint32_t key = ubx::f9_msgout_map.at(msg_class).at(msg_id) + port;
+
+  // Remember what the message was doing before, to restore it afterwards
+  if (!rate_known(key) && cfg_get(std::vector<uint32_t>{ key }, timeout))
+    rate_found(key, m_cfg.value<uint8_t>(key));
+
+  bool confirmed = send_rates(subscription_changes(key, rate, true), timeout);
+
+  std::weak_ptr<bool> alive = m_alive;
+
+  return ubx::subscription([this, alive, key, rate, timeout]()
+      {
+        if (!alive.expired())
+          send_rates(subscription_changes(key, rate, false), timeout);
+      }, confirmed);
+}
+
+bool f9::send_rates(const std::map<uint32_t, uint8_t>& changes,
+    size_t timeout)
+{
+  bool confirmed = cfg_set(std::map<uint32_t, uint64_t>(changes.begin(),
+        changes.end()), 0x01, timeout);
+
+  rates_applied(changes, confirmed);
+
+  return confirmed;
+}
+
+bool f9::cfg_get(const std::vector<uint32_t>& keys, size_t timeout)
+{
+  std::vector<uint32_t> query = m_cfg.missing(keys);
+
+  if (query.empty())
+    return true;
+
+  // CFG-VALGET accepts at most 64 keys per poll
+  const size_t max_keys = 64;
+  const size_t commands = (query.size() + max_keys - 1) / max_keys;
+
+  const auto& cfg = ubx::f9_map.at("CFG");
+  const uint8_t cfg_valget = cfg.second.at("VALGET");
+
+  std::vector<uint8_t> buffer(commands * ubx::frame_size<uint32_t>::value
+      + query.size() * sizeof (uint32_t));
+
+  ubx::encoder batch(buffer.data(), buffer.size());
+
+  for (size_t i = 0; i < commands; ++i)
+  {
+    const size_t first = i * max_keys;
+    const size_t count = std::min(max_keys, query.size() - first);
+
+    batch.begin(cfg.first, cfg_valget, 4 + count * sizeof (uint32_t));
+
+    batch.put<uint8_t>(0x00); // version
+    batch.put<uint8_t>(0x00); // layer: RAM
+    batch.put<uint16_t>(0x0000); // position
+
+    for (size_t j = first; j < first + count; ++j)
+      batch.put<uint32_t>(query[j]);
+
+    batch.end();
+  }
+
+  ubx_send(batch);
+
+  // Each response precedes its ACK, so once the ACKs are in so are the values
+  await_acks(cfg.first, cfg_valget, commands, timeout);
+
+  for (auto it = m_ubx_buffer.begin(); it != m_ubx_buffer.end(); )
+  {
+    if (m_cfg.store(*it) > 0)
+      it = m_ubx_buffer.erase(it);
+    else
+      ++it;
+  }
+
+  return m_cfg.missing(query).empty();
+}
+
+bool f9::cfg_get(const std::vector<std::string>& names, size_t timeout)
+{
+  std::vector<uint32_t> keys;
+
+  for (const auto& name : names)
+    keys.push_back(ubx::cfg::find(name).id);
+
+  return cfg_get(keys, timeout);
+}
+
+bool f9::cfg_set(const std::map<uint32_t, uint64_t>& values, uint8_t layers,
+    size_t timeout)
+{
+  if (values.empty())
+    return true;
+
+  // CFG-VALSET accepts at most 64 key/value pairs per message
+  const size_t max_keys = 64;
+  const size_t commands = (values.size() + max_keys - 1) / max_keys;
+
+  const auto& cfg = ubx::f9_map.at("CFG");
+  const uint8_t cfg_valset = cfg.second.at("VALSET");
+
+  size_t length = commands * ubx::frame_size<uint32_t>::value;
+
+  for (const auto& value : values)
+    length += sizeof (uint32_t) + ubx::cfg::size(value.first);
+
+  std::vector<uint8_t> buffer(length);
+
+  ubx::encoder batch(buffer.data(), buffer.size());
+
+  auto value = values.begin();
+
+  for (size_t i = 0; i < commands; ++i)
+  {
+    const size_t keys = std::min(max_keys, values.size() - i * max_keys);
+
+    size_t payload = 4;
+
+    auto it = value;
+    for (size_t j = 0; j < keys; ++j, ++it)
+      payload += sizeof (uint32_t) + ubx::cfg::size(it->first);
+
+    batch.begin(cfg.first, cfg_valset, payload);
+
+    // More than one command is sent as a transaction, so the receiver applies
+    //   all of the values on the last command or none of them
+    uint8_t transaction = 0; // none
+
+    if (commands > 1)
+      transaction = i == 0 ? 1 : i + 1 < commands ? 2 : 3;
+
+    batch.put<uint8_t>(commands > 1 ? 0x01 : 0x00); // version
+    batch.put<uint8_t>(layers);
+    batch.put<uint8_t>(transaction); // 1 (re)start, 2 ongoing, 3 apply
+    batch.put<uint8_t>(0x00); // reserved
+
+    for (size_t j = 0; j < keys; ++j, ++value)
+    {
+      batch.put<uint32_t>(value->first);
+
+      switch (ubx::cfg::size(value->first))
+      {
+        case 1: batch.put<uint8_t>(value->second); break;
+        case 2: batch.put<uint16_t>(value->second); break;
+        case 4: batch.put<uint32_t>(value->second); break;
+        case 8: batch.put<uint64_t>(value->second); break;
+        default: throw std::runtime_error("Invalid configuration key ID");
+      }
+
+      // Read back on the next cfg_get rather than trusting the written value
+      m_cfg.invalidate(value->first);
+    }
+
+    batch.end();
+  }
+
+  ubx_send(batch);
+
+  return await_acks(cfg.first, cfg_valset, commands, timeout) == commands;
+}
+
+const ubx::cfg::cache& f9::cfg() const
+{
+  return m_cfg;
+}
+
+bool f9::change_baud_rate(size_t baud_rate, ubx::port_id port,
+    size_t timeout)
+{
+  if (port != ubx::uart1 && port != ubx::uart2)
+    throw std::runtime_error("Baud rate only applies to UART ports");
+
+  const uint32_t key = ubx::cfg::find(port == ubx::uart1
+      ? "CFG-UART1-BAUDRATE" : "CFG-UART2-BAUDRATE").id;
+
+  // The acknowledgement may be sent at either rate, so don't wait for it
+  cfg_set({{key, baud_rate}}, 0x01, 0);
+
+  bool changed = follow_baud_rate(baud_rate, timeout);
+
+  // Drop the CFG-VALSET acknowledgement if it survived the switch, so it isn't
+  //   mistaken for the answer to a later command
+  const auto& cfg = ubx::f9_map.at("CFG");
+  await_acks(cfg.first, cfg.second.at("VALSET"), 1, 0);
+
+  return changed;
+}
+
 } // namespace cracl
@@ -22,12 +22,15 @@
 #define CRACL_UBLOX_F9_HPP
 
 #include "base.hpp"
+#include "msg/cfg.hpp"
 #include "msg/f9.hpp"
 #include "../base/device.hpp"
 
 #include <deque>
 #include <iomanip>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cracl
@@ -35,6 +38,12 @@ namespace cracl
 
 class f9 : public ublox_base
 {
+protected:
+  // Receiver configuration (RAM layer) read back with CFG-VALGET
+  ubx::cfg::cache m_cfg;
+
+  bool send_rates(const std::map<uint32_t, uint8_t>& changes, size_t timeout);
+
 public:
   f9(const std::string& location, size_t baud_rate=9600, size_t timeout=500,
       size_t char_size=8, std::string delim="\r\n", size_t max_handlers=100000,
@@ -47,29 +56,152 @@ public:
   std::vector<uint8_t> fetch_ubx(std::string&& msg_class,
       std::string&& msg_id, bool first_try=true);
 
+  using ublox_base::ubx_send;
+
   template <typename... Args>
   void ubx_send(std::string&& msg_class, std::string&& msg_id, Args... args)
   {
-    std::vector<uint8_t> message = { 0xb5 /*μ*/, 'b',
-      ubx::f9_map.at(msg_class).first,
-      ubx::f9_map.at(msg_class).second.at(msg_id) };
+    // Sized at compile time from the argument types, no heap allocation
+    ubx::static_encoder<ubx::frame_size<Args...>::value> message;
+
+    ubx_encode(message, std::forward<std::string>(msg_class),
+        std::forward<std::string>(msg_id), args...);
 
-    uint16_t length = payload_size(args...);
-    message.reserve(2 + length + 2);
+    ubx_send(message);
+  }
+
+  using ublox_base::poll_many;
+
+  /* @brief Poll several messages, by name, in a single write and collect the
+   *        responses as they arrive
+   *
+   * @param timeout Time in milliseconds to wait for all responses
+   */
+  ubx::poll_result poll_many(
+      const std::vector<std::pair<std::string, std::string>>& messages,
+      size_t timeout=1000);
+
+  /* @brief As above, parsing each response into its type, e.g.
+   *        poll_many<ubx::nav::timegps, ubx::nav::timeutc>()
+   */
+  template <typename... Messages>
+  ubx::polled<Messages...> poll_many(size_t timeout=1000)
+  {
+    ubx::poll_result raw = poll_many(
+        {{Messages::msg_class(), Messages::msg_id()}...}, timeout);
 
-    add_ubx_payload(message, length, args...);
+    return ubx::polled<Messages...>(raw);
+  }
 
-    uint8_t check_a = 0;
-    uint8_t check_b = 0;
+  /* @brief Append a message to an encoder without sending it, so that several
+   *        messages can be batched into one write with ubx_send(batch)
+   */
+  template <typename... Args>
+  void ubx_encode(ubx::encoder& batch, std::string&& msg_class,
+      std::string&& msg_id, Args... args)
+  {
+    const auto& msg = ubx::f9_map.at(msg_class);
 
-    // Compute 8-bit Fletcher checksum
-    for (size_t i = 2; i < message.size(); ++i)
-      check_b += (check_a += message[i]);
+    batch.add(msg.first, msg.second.at(msg_id), args...);
+  }
 
-    message.push_back(check_a);
-    message.push_back(check_b);
+  /* @brief Configure the receiver to output exactly the messages in a
+   *        profile, at the given rates, on the given port
+   *
+   * Only messages whose rate differs from the last confirmed configuration
+   * are sent (messages no longer in the profile are disabled). The changes
+   * are packed into as few multi-key CFG-VALSET commands as possible, which
+   * go out in a single write and are confirmed by one sweep of the ACK
+   * responses. Rates are applied to the RAM layer.
+   *
+   * @param timeout Time in milliseconds to wait for acknowledgement
+   *
+   * @return True if every command was acknowledged
+   */
+  bool apply_rates(const ubx::rate_profile& profile,
+      ubx::port_id port=ubx::usb, size_t timeout=1000);
+
+  /* @brief Have the receiver output a message for as long as the returned
+   *        handle lives, on the given port. Subscribers are counted, the
+   *        receiver outputs at the most frequent rate any of them needs
+   *        (alongside apply_rates profiles). When the last leaves it
+   *        returns to the profile's rate, or to the rate read back before
+   *        the first subscriber, otherwise stops
+   *
+   * @param rate Output once every rate navigation solutions (1 for each)
+   * @param timeout Time in milliseconds to wait for acknowledgement, also
+   *        used when the subscription is released
+   */
+  ubx::subscription subscribe(const std::string& msg_class,
+      const std::string& msg_id, uint8_t rate=1, ubx::port_id port=ubx::usb,
+      size_t timeout=1000);
+
+  /* @brief As above by type, e.g. subscribe<ubx::nav::sig>()
+   */
+  template <typename Message>
+  ubx::subscription subscribe(uint8_t rate=1, ubx::port_id port=ubx::usb,
+      size_t timeout=1000)
+  {
+    return subscribe(Message::msg_class(), Message::msg_id(), rate, port,
+        timeout);
+  }
 
-    write(message);
+  /* @brief Change the baud rate of one of the receiver's UARTs and switch the
+   *        host port to match
+   *
+   * The rate is written to the RAM layer with CFG-VALSET. After the switch
+   * the link is verified with a poll, and the host returns to the previous
+   * rate if it fails.
+   *
+   * @param timeout Time in milliseconds to wait for each step
+   *
+   * @return True if the receiver answered at the new rate, false if it
+   *         answered at the previous rate
+   *
+   * Throws if the receiver answers at neither rate
+   */
+  bool change_baud_rate(size_t baud_rate, ubx::port_id port=ubx::uart1,
+      size_t timeout=1000);
+
+  /* @brief Read configuration values from the RAM layer into the local cache
+   *
+   * Keys already cached are not queried again. The remaining keys are packed
+   * into as few CFG-VALGET polls as possible (64 keys each), which are sent
+   * in a single write.
+   *
+   * @param timeout Time in milliseconds to wait for the responses
+   *
+   * @return True if every requested key is now cached
+   */
+  bool cfg_get(const std::vector<uint32_t>& keys, size_t timeout=1000);
+
+  bool cfg_get(const std::vector<std::string>& names, size_t timeout=1000);
+
+  /* @brief Write configuration values with as few CFG-VALSET commands as
+   *        possible, sent in a single write. Every key written is dropped
+   *        from the local cache so that the next cfg_get reads it back
+   *
+   * More than 64 values take several commands, which are sent as one
+   * CFG-VALSET transaction: the receiver applies them together with the last
+   * command, and discards all of them if any command is rejected.
+   *
+   * @param values Key IDs and raw values (only the key's size is sent)
+   * @param layers Bit mask of layers to write (0x01 RAM, 0x02 BBR, 0x04 Flash)
+   * @param timeout Time in milliseconds to wait for acknowledgement
+   *
+   * @return True if every command was acknowledged
+   */
+  bool cfg_set(const std::map<uint32_t, uint64_t>& values,
+      uint8_t layers=0x01, size_t timeout=1000);
+
+  /* @brief Cached configuration values, filled by cfg_get
+   */
+  const ubx::cfg::cache& cfg() const;
+
+  template <typename T>
+  T cfg_value(const std::string& name) const
+  {
+    return m_cfg.value<T>(ubx::cfg::find(name).id);
   }
 
 };
@@ -0,0 +1,246 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "join.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace
+{
+
+// Epochs further in the past than this are taken as the receiver having been
+//   reset (or its time corrected) rather than as late
+const int64_t reset_window = 60000;
+
+} // namespace
+
+epoch_join::epoch_join(size_t receivers, size_t tolerance,
+    size_t max_latency, size_t max_open)
+  : m_receivers (receivers), m_tolerance (tolerance),
+  m_max_latency (max_latency), m_max_open (max_open == 0 ? 1 : max_open),
+  m_emitted (false), m_last_iTOW (0), m_last_week (-1),
+  m_late (receivers, 0), m_missing (receivers, 0), m_dropped (0)
+{
+  if (receivers == 0)
+    throw std::runtime_error("No receivers to join");
+}
+
+void epoch_join::add(size_t receiver, epoch&& e,
+    epoch::clock::time_point now)
+{
+  if (receiver >= m_receivers)
+    throw std::runtime_error("Receiver index out of range");
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const int64_t tolerance = static_cast<int64_t>(m_tolerance);
+
+  if (m_emitted)
+  {
+    const int64_t diff = time_difference(e.iTOW, e.week, m_last_iTOW,
+        m_last_week);
+
+    if (diff <= tolerance && diff > -reset_window)
+    {
+      ++m_late[receiver];
+
+      return;
+    }
+  }
+
+  // Open records are kept in time order, find a match or where one goes
+  auto it = m_open.begin();
+
+  for (; it != m_open.end(); ++it)
+  {
+    const int64_t diff = time_difference(e.iTOW, e.week, it->data.iTOW,
+        it->data.week);
+
+    if (diff <= tolerance)
+      break;
+  }
+
+  if (it == m_open.end() || time_difference(e.iTOW, e.week, it->data.iTOW,
+        it->data.week) < -tolerance)
+  {
+    if (m_open.size() == m_max_open)
+    {
+      if (it == m_open.begin())  // Older than everything held, and the
+      {                          //   oldest is about to be delivered
+        ++m_late[receiver];
+
+        return;
+      }
+
+      emit();
+    }
+
+    record r;
+
+    r.data.iTOW = e.iTOW;
+    r.data.week = -1;
+    r.data.epochs.resize(m_receivers);
+    r.data.present.assign(m_receivers, false);
+    r.data.count = 0;
+    r.arrival = now;
+
+    // Find the position again, emit() may have removed the front
+    it = m_open.begin();
+
+    while (it != m_open.end() && time_difference(e.iTOW, e.week,
+          it->data.iTOW, it->data.week) > 0)
+      ++it;
+
+    it = m_open.insert(it, std::move(r));
+  }
+  else if (it->data.present[receiver])
+  {
+    ++m_late[receiver];
+
+    return;
+  }
+
+  if (it->data.week < 0)
+    it->data.week = e.week;
+
+  it->data.epochs[receiver] = std::move(e);
+  it->data.present[receiver] = true;
+  ++it->data.count;
+
+  emit_ready(now);
+
+  if (!m_ready.empty())
+    m_available.notify_one();
+}
+
+void epoch_join::emit()
+{
+  aligned& data = m_open.front().data;
+
+  for (size_t i = 0; i < m_receivers; ++i)
+    if (!data.present[i])
+      ++m_missing[i];
+
+  if (!m_emitted || time_difference(data.iTOW, data.week, m_last_iTOW,
+        m_last_week) > 0)
+  {
+    m_last_iTOW = data.iTOW;
+    m_last_week = data.week;
+  }
+
+  m_emitted = true;
+
+  m_ready.push_back(std::move(data));
+
+  m_open.pop_front();
+
+  if (m_ready.size() > m_max_open)
+  {
+    m_ready.pop_front();
+
+    ++m_dropped;
+  }
+}
+
+void epoch_join::emit_ready(epoch::clock::time_point now)
+{
+  while (!m_open.empty() && (m_open.front().data.count == m_receivers
+        || now - m_open.front().arrival
+          >= std::chrono::milliseconds(m_max_latency)))
+    emit();
+}
+
+bool epoch_join::next(aligned& result, size_t timeout)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  auto deadline = epoch::clock::now() + std::chrono::milliseconds(timeout);
+
+  while (true)
+  {
+    auto now = epoch::clock::now();
+
+    emit_ready(now);
+
+    if (!m_ready.empty())
+    {
+      result = std::move(m_ready.front());
+
+      m_ready.pop_front();
+
+      return true;
+    }
+
+    if (now >= deadline)
+      return false;
+
+    // Wake for new epochs, or when the oldest record stops waiting
+    auto wake = deadline;
+
+    if (!m_open.empty())
+      wake = std::min(wake, m_open.front().arrival
+          + std::chrono::milliseconds(m_max_latency));
+
+    m_available.wait_until(lock, wake);
+  }
+}
+
+size_t epoch_join::receivers() const
+{
+  return m_receivers;
+}
+
+size_t epoch_join::late(size_t receiver) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_late.at(receiver);
+}
+
+size_t epoch_join::missing(size_t receiver) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_missing.at(receiver);
+}
+
+size_t epoch_join::dropped() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_dropped;
+}
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,146 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_JOIN_HPP
+#define CRACL_UBLOX_JOIN_HPP
+
+#include "epoch.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Epochs from several receivers for the same GPS time
+ */
+struct aligned
+{
+  uint32_t iTOW;
+
+  // GPS week if any receiver reported it, otherwise -1
+  int32_t week;
+
+  // One epoch per receiver, only meaningful where present is set
+  std::vector<epoch> epochs;
+  std::vector<bool> present;
+
+  // Number of receivers present
+  size_t count;
+
+};
+
+/* @brief Matches epochs from several receivers by GPS time
+ *
+ * Each receiver is read on its own thread (e.g. with fetch_epoch) and its
+ * epochs passed to add(). Records are delivered in time order by next() as
+ * soon as every receiver has contributed, or once the oldest epoch in them
+ * has waited max_latency, with the absent receivers counted as missing. At
+ * most max_open records are held open and max_open delivered records are
+ * buffered, beyond which the oldest are dropped.
+ */
+class epoch_join
+{
+  struct record
+  {
+    aligned data;
+
+    epoch::clock::time_point arrival;
+  };
+
+  size_t m_receivers;
+  size_t m_tolerance;
+  size_t m_max_latency;
+  size_t m_max_open;
+
+  std::deque<record> m_open;
+  std::deque<aligned> m_ready;
+
+  bool m_emitted;
+  uint32_t m_last_iTOW;
+  int32_t m_last_week;
+
+  std::vector<size_t> m_late;
+  std::vector<size_t> m_missing;
+  size_t m_dropped;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_available;
+
+  /* @brief Deliver the oldest open record (caller must hold m_mutex)
+   */
+  void emit();
+
+  /* @brief Deliver open records that are complete or have waited too long,
+   *        oldest first (caller must hold m_mutex)
+   */
+  void emit_ready(epoch::clock::time_point now);
+
+public:
+  /* @param receivers Number of receivers being joined
+   * @param tolerance Largest time difference in milliseconds between epochs
+   *        considered to be the same
+   * @param max_latency Milliseconds to wait for missing receivers
+   * @param max_open Most records held open or buffered for delivery
+   */
+  epoch_join(size_t receivers, size_t tolerance=0, size_t max_latency=1000,
+      size_t max_open=8);
+
+  /* @brief Add an epoch from a receiver, indexed from 0
+   */
+  void add(size_t receiver, epoch&& e,
+      epoch::clock::time_point now=epoch::clock::now());
+
+  /* @brief Wait for the next aligned record
+   *
+   * @param timeout Time in milliseconds to wait, 0 to only check
+   *
+   * @return False if no record was delivered before the timeout
+   */
+  bool next(aligned& result, size_t timeout);
+
+  size_t receivers() const;
+
+  /* @brief Epochs from a receiver that arrived after their time was
+   *        delivered, or duplicated one already held
+   */
+  size_t late(size_t receiver) const;
+
+  /* @brief Delivered records a receiver was absent from
+   */
+  size_t missing(size_t receiver) const;
+
+  /* @brief Records discarded because next() was not called often enough
+   */
+  size_t dropped() const;
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_JOIN_HPP
@@ -0,0 +1,130 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "latest.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+latest_value::latest_value(size_t capacity)
+  : m_words ((capacity + 7) / 8)
+{
+  m_slot.clear();
+
+  for (auto& word : m_words)
+    word.store(0, std::memory_order_relaxed);
+}
+
+size_t latest_value::capacity() const
+{
+  return m_words.size() * 8;
+}
+
+bool latest_value::store(const uint8_t* frame, size_t size)
+{
+  if (size > capacity())
+    return false;
+
+  m_slot.store(m_words.data(),
+      m_slot.sequence.load(std::memory_order_relaxed) + 2, frame, size);
+
+  return true;
+}
+
+uint32_t latest_value::load(uint8_t* buffer, size_t buffer_size,
+    size_t& size) const
+{
+  return static_cast<uint32_t>(m_slot.load(m_words.data(), buffer,
+        buffer_size, size) / 2);
+}
+
+uint32_t latest_value::sequence() const
+{
+  return static_cast<uint32_t>(
+      m_slot.sequence.load(std::memory_order_acquire) / 2);
+}
+
+const latest_value& latest_cache::track(uint8_t msg_class, uint8_t msg_id,
+    size_t capacity)
+{
+  auto& slot = m_slots[static_cast<uint16_t>(msg_class << 8 | msg_id)];
+
+  // Readers may already hold the slot, so it can't be replaced
+  if (!slot)
+    slot.reset(new latest_value(capacity));
+  else if (slot->capacity() < capacity)
+    throw std::runtime_error("Message type already tracked with a smaller "
+        "capacity");
+
+  return *slot;
+}
+
+const latest_value* latest_cache::find(uint8_t msg_class,
+    uint8_t msg_id) const
+{
+  auto it = m_slots.find(static_cast<uint16_t>(msg_class << 8 | msg_id));
+
+  return it == m_slots.end() ? nullptr : it->second.get();
+}
+
+bool latest_cache::update(std::vector<uint8_t>& frame)
+{
+  if (frame.size() < 8)
+    return false;
+
+  auto it = m_slots.find(static_cast<uint16_t>(frame[2] << 8 | frame[3]));
+
+  if (it == m_slots.end() || !valid_checksum(frame))
+    return false;
+
+  return it->second->store(frame.data(), frame.size());
+}
+
+bool latest_cache::update(const std::vector<uint8_t>& frame, bool valid)
+{
+  if (!valid || frame.size() < 8)
+    return false;
+
+  auto it = m_slots.find(static_cast<uint16_t>(frame[2] << 8 | frame[3]));
+
+  if (it == m_slots.end())
+    return false;
+
+  return it->second->store(frame.data(), frame.size());
+}
+
+bool latest_cache::empty() const
+{
+  return m_slots.empty();
+}
+
+} // namespace ubx
+
+} // namespace cracl
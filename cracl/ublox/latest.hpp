@@ -0,0 +1,120 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_LATEST_HPP
+#define CRACL_UBLOX_LATEST_HPP
+
+#include "msg/base.hpp"
+#include "../base/frame_slot.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Most recent frame of one message type, written by a single thread
+ *        (the framer) and readable from any number of threads
+ *
+ * Access is guarded by a sequence lock, lock-free for the writer; readers
+ * retry. The writer never waits, and readers copy the frame out without
+ * taking a lock, retrying if an update happened during the copy.
+ */
+class latest_value
+{
+  frame_slot m_slot;
+
+  std::vector<std::atomic<uint64_t>> m_words;
+
+public:
+  /* @param capacity Largest frame (including framing) kept, in bytes
+   */
+  latest_value(size_t capacity);
+
+  size_t capacity() const;
+
+  /* @brief Replace the held frame (single writer only)
+   *
+   * @return False if the frame is larger than the capacity and was not kept
+   */
+  bool store(const uint8_t* frame, size_t size);
+
+  /* @brief Copy the held frame into a buffer (e.g. to construct a view)
+   *
+   * @param size Set to the size of the frame, which is only partly copied if
+   *        larger than the buffer
+   *
+   * @return Number of updates made to the value when the frame was copied, 0
+   *         if nothing has been received yet
+   */
+  uint32_t load(uint8_t* buffer, size_t buffer_size, size_t& size) const;
+
+  /* @brief Number of updates so far, e.g. to check for a new frame without
+   *        copying it
+   */
+  uint32_t sequence() const;
+
+};
+
+/* @brief Latest value of each tracked message type, keyed by class and ID
+ *
+ * Types must be tracked before reader threads start, since the set of slots
+ * is not itself protected.
+ */
+class latest_cache
+{
+  std::map<uint16_t, std::unique_ptr<latest_value>> m_slots;
+
+public:
+  /* @brief Start keeping the latest frame of a message type. Tracking a type
+   *        again returns the existing slot
+   */
+  const latest_value& track(uint8_t msg_class, uint8_t msg_id,
+      size_t capacity);
+
+  /* @brief Slot for a message type, nullptr if it isn't tracked
+   */
+  const latest_value* find(uint8_t msg_class, uint8_t msg_id) const;
+
+  /* @brief Store a frame if its type is tracked and its checksum is valid
+   *
+   * @return True if the frame was stored
+   */
+  bool update(std::vector<uint8_t>& frame);
+
+  /* @brief As above, with the checksum already checked by the caller
+   */
+  bool update(const std::vector<uint8_t>& frame, bool valid);
+
+  bool empty() const;
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_LATEST_HPP
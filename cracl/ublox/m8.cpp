@@ -22,6 +22,14 @@
 
 #include "../base/device.hpp"
 
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace cracl
 {
 
@@ -66,4 +74,198 @@ std::vector<uint8_t> m8::fetch_ubx(std::string&& msg_class,
   return temp;
 }
 
+ubx::poll_result m8::poll_many(
+    const std::vector<std::pair<std::string, std::string>>& messages,
+    size_t timeout)
+{
+  std::vector<std::pair<uint8_t, uint8_t>> ids;
+
+  ids.reserve(messages.size());
+
+  for (const auto& name : messages)
+  {
+    const auto& msg = ubx::m8_map.at(name.first);
+
+    ids.emplace_back(msg.first, msg.second.at(name.second));
+  }
+
+  return poll_many(ids, timeout);
+}
+
+bool m8::apply_rates(const ubx::rate_profile& profile, size_t timeout)
+{
+  std::map<uint32_t, uint8_t> desired;
+
+  // Key each message by its class and ID
+  for (const auto& msg_class : profile)
+  {
+    const auto& msg = ubx::m8_map.at(msg_class.first);
+
+    for (const auto& msg_id : msg_class.second)
+      desired[msg.first << 8 | msg.second.at(msg_id.first)] = msg_id.second;
+  }
+
+  if (!send_rates(rate_changes(desired), timeout))
+    return false;
+
+  // A rejected profile leaves the last one in place
+  profile_applied(desired);
+
+  return true;
+}
+
+ubx::subscription m8::subscribe(const std::string& msg_class,
+    const std::string& msg_id, uint8_t rate, size_t timeout)
+{
+  if (rate == 0)
+    throw std::runtime_error("Subscription rate must be at least 1");
+
+  const auto& msg = ubx::m8_map.at(msg_class);
+  const uint32_t key = msg.first << 8 | msg.second.at(msg_id);
+
+  // Remember what the message was doing before, to restore it afterwards
+  uint8_t previous;
+
+  if (!rate_known(key) && poll_rate(key, previous, timeout))
+    rate_found(key, previous);
+
+  bool confirmed = send_rates(subscription_changes(key, rate, true), timeout);
+
+  std::weak_ptr<bool> alive = m_alive;
+
+  return ubx::subscription([this, alive, key, rate, timeout]()
+      {
+        if (!alive.expired())
+          send_rates(subscription_changes(key, rate, false), timeout);
+      }, confirmed);
+}
+
+bool m8::send_rates(const std::map<uint32_t, uint8_t>& changes,
+    size_t timeout)
+{
+  if (changes.empty())
+    return true;
+
+  const auto& cfg = ubx::m8_map.at("CFG");
+  const uint8_t cfg_msg = cfg.second.at("MSG");
+
+  std::vector<uint8_t> buffer(changes.size()
+      * ubx::frame_size<uint8_t, uint8_t, uint8_t>::value);
+
+  ubx::encoder batch(buffer.data(), buffer.size());
+
+  // CFG-MSG with a 3 byte payload sets the rate on the current port
+  for (const auto& rate : changes)
+    batch.add(cfg.first, cfg_msg, static_cast<uint8_t>(rate.first >> 8),
+        static_cast<uint8_t>(rate.first), rate.second);
+
+  ubx_send(batch);
+
+  bool confirmed = await_acks(cfg.first, cfg_msg, changes.size(), timeout)
+    == changes.size();
+
+  rates_applied(changes, confirmed);
+
+  return confirmed;
+}
+
+bool m8::poll_rate(uint32_t key, uint8_t& rate, size_t timeout)
+{
+  const auto& cfg = ubx::m8_map.at("CFG");
+  const uint8_t cfg_msg = cfg.second.at("MSG");
+
+  const uint8_t msg_class = static_cast<uint8_t>(key >> 8);
+  const uint8_t msg_id = static_cast<uint8_t>(key);
+
+  ubx::static_encoder<ubx::frame_size<uint8_t, uint8_t>::value> poll;
+
+  poll.add(cfg.first, cfg_msg, msg_class, msg_id);
+
+  ubx_send(poll);
+
+  // The response precedes its ACK, so once the ACK is in so is the response
+  await_acks(cfg.first, cfg_msg, 1, timeout);
+
+  for (auto it = m_ubx_buffer.begin(); it != m_ubx_buffer.end(); ++it)
+  {
+    // Response carries the rate on each of the 6 I/O ports
+    if (it->size() == 16 && (*it)[2] == cfg.first && (*it)[3] == cfg_msg
+        && (*it)[6] == msg_class && (*it)[7] == msg_id
+        && ubx::valid_checksum(*it))
+    {
+      std::vector<uint8_t> response = std::move(*it);
+
+      m_ubx_buffer.erase(it);
+
+      for (size_t i = ubx::uart1; i <= ubx::spi; ++i)
+        if (response[8 + i] != response[8 + ubx::ddc])
+          return false;
+
+      rate = response[8 + ubx::ddc];
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool m8::change_baud_rate(size_t baud_rate, ubx::port_id port,
+    size_t timeout)
+{
+  if (port != ubx::uart1 && port != ubx::uart2)
+    throw std::runtime_error("Baud rate only applies to UART ports");
+
+  uint16_t tx_ready;
+  uint32_t mode;
+  uint16_t in_proto;
+  uint16_t out_proto;
+  uint16_t flags;
+
+  bool found = false;
+
+  ubx_send("CFG", "PRT", static_cast<uint8_t>(port));
+
+  auto deadline = std::chrono::steady_clock::now()
+    + std::chrono::milliseconds(timeout);
+
+  do
+  {
+    std::vector<uint8_t> current = fetch_ubx("CFG", "PRT");
+
+    if (current.size() == 28 && current[6] == port
+        && ubx::valid_checksum(current))
+    {
+      tx_ready = ubx::field<uint16_t>(current, 8);
+      mode = ubx::field<uint32_t>(current, 10);
+      in_proto = ubx::field<uint16_t>(current, 18);
+      out_proto = ubx::field<uint16_t>(current, 20);
+      flags = ubx::field<uint16_t>(current, 22);
+
+      found = true;
+
+      break;
+    }
+  }
+  while (std::chrono::steady_clock::now() < deadline);
+
+  // Guessing the rest of the port configuration could switch off protocols
+  //   in use, so leave the port alone
+  if (!found)
+    return false;
+
+  ubx_send("CFG", "PRT", static_cast<uint8_t>(port), static_cast<uint8_t>(0),
+      tx_ready, mode, static_cast<uint32_t>(baud_rate), in_proto, out_proto,
+      flags, static_cast<uint16_t>(0));
+
+  bool changed = follow_baud_rate(baud_rate, timeout);
+
+  // Drop the CFG-PRT acknowledgement if it survived the switch, so it isn't
+  //   mistaken for the answer to a later command
+  const auto& cfg = ubx::m8_map.at("CFG");
+  await_acks(cfg.first, cfg.second.at("PRT"), 1, 0);
+
+  return changed;
+}
+
 } // namespace cracl
@@ -27,7 +27,9 @@
 
 #include <deque>
 #include <iomanip>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace cracl
@@ -35,6 +37,15 @@ namespace cracl
 
 class m8 : public ublox_base
 {
+protected:
+  bool send_rates(const std::map<uint32_t, uint8_t>& changes, size_t timeout);
+
+  /* @brief Poll the output rate of a message with CFG-MSG. The rate is only
+   *        reported if it is the same on every port, as commands set the
+   *        rate on whichever port they arrive on and that port isn't known
+   */
+  bool poll_rate(uint32_t key, uint8_t& rate, size_t timeout);
+
 public:
   m8(const std::string& location, size_t baud_rate=9600, size_t timeout=500,
       size_t char_size=8, std::string delim="\r\n", size_t max_handlers=100000,
@@ -47,31 +58,109 @@ public:
   std::vector<uint8_t> fetch_ubx(std::string&& msg_class,
       std::string&& msg_id, bool first_try=true);
 
+  using ublox_base::ubx_send;
+
   template <typename... Args>
   void ubx_send(std::string&& msg_class, std::string&& msg_id, Args... args)
   {
-    std::vector<uint8_t> message = { 0xb5 /*μ*/, 'b',
-      ubx::m8_map.at(msg_class).first,
-      ubx::m8_map.at(msg_class).second.at(msg_id) };
+    // Sized at compile time from the argument types, no heap allocation
+    ubx::static_encoder<ubx::frame_size<Args...>::value> message;
 
-    uint16_t length = payload_size(args...);
-    message.reserve(2 + length + 2);
+    ubx_encode(message, std::forward<std::string>(msg_class),
+        std::forward<std::string>(msg_id), args...);
 
-    add_ubx_payload(message, length, args...);
+    ubx_send(message);
+  }
+
+  using ublox_base::poll_many;
+
+  /* @brief Poll several messages, by name, in a single write and collect the
+   *        responses as they arrive
+   *
+   * @param timeout Time in milliseconds to wait for all responses
+   */
+  ubx::poll_result poll_many(
+      const std::vector<std::pair<std::string, std::string>>& messages,
+      size_t timeout=1000);
+
+  /* @brief As above, parsing each response into its type, e.g.
+   *        poll_many<ubx::nav::timegps, ubx::nav::timeutc>()
+   */
+  template <typename... Messages>
+  ubx::polled<Messages...> poll_many(size_t timeout=1000)
+  {
+    ubx::poll_result raw = poll_many(
+        {{Messages::msg_class(), Messages::msg_id()}...}, timeout);
 
-    uint8_t check_a = 0;
-    uint8_t check_b = 0;
+    return ubx::polled<Messages...>(raw);
+  }
 
-    // Compute 8-bit Fletcher checksum
-    for (size_t i = 2; i < message.size(); ++i)
-      check_b += (check_a += message[i]);
+  /* @brief Append a message to an encoder without sending it, so that several
+   *        messages can be batched into one write with ubx_send(batch)
+   */
+  template <typename... Args>
+  void ubx_encode(ubx::encoder& batch, std::string&& msg_class,
+      std::string&& msg_id, Args... args)
+  {
+    const auto& msg = ubx::m8_map.at(msg_class);
 
-    message.push_back(check_a);
-    message.push_back(check_b);
+    batch.add(msg.first, msg.second.at(msg_id), args...);
+  }
 
-    write(message);
+  /* @brief Configure the receiver to output exactly the messages in a
+   *        profile, at the given rates, on the port in use
+   *
+   * Only messages whose rate differs from the last confirmed configuration
+   * are sent (messages no longer in the profile are disabled). The CFG-MSG
+   * commands go out in a single write and are confirmed by one sweep of the
+   * ACK responses.
+   *
+   * @param timeout Time in milliseconds to wait for acknowledgement
+   *
+   * @return True if every command was acknowledged
+   */
+  bool apply_rates(const ubx::rate_profile& profile, size_t timeout=1000);
+
+  /* @brief Have the receiver output a message for as long as the returned
+   *        handle lives, on the port in use. Subscribers are counted, the
+   *        receiver outputs at the most frequent rate any of them needs
+   *        (alongside apply_rates profiles). When the last leaves it
+   *        returns to the profile's rate, or to the rate polled before the
+   *        first subscriber (if the same on every port), otherwise stops
+   *
+   * @param rate Output once every rate navigation solutions (1 for each)
+   * @param timeout Time in milliseconds to wait for acknowledgement, also
+   *        used when the subscription is released
+   */
+  ubx::subscription subscribe(const std::string& msg_class,
+      const std::string& msg_id, uint8_t rate=1, size_t timeout=1000);
+
+  /* @brief As above by type, e.g. subscribe<ubx::nav::sig>()
+   */
+  template <typename Message>
+  ubx::subscription subscribe(uint8_t rate=1, size_t timeout=1000)
+  {
+    return subscribe(Message::msg_class(), Message::msg_id(), rate, timeout);
   }
 
+  /* @brief Change the baud rate of one of the receiver's UARTs and switch the
+   *        host port to match
+   *
+   * The current CFG-PRT settings of the port are polled first so that only
+   * the baud rate changes. After the switch the link is verified with a
+   * poll, and the host returns to the previous rate if it fails.
+   *
+   * @param timeout Time in milliseconds to wait for each step
+   *
+   * @return True if the receiver answered at the new rate, false if the
+   *         port settings couldn't be read (nothing is changed) or the
+   *         receiver answered at the previous rate
+   *
+   * Throws if the receiver answers at neither rate
+   */
+  bool change_baud_rate(size_t baud_rate, ubx::port_id port=ubx::uart1,
+      size_t timeout=1000);
+
 };
 
 } // namespace cracl
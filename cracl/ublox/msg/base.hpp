@@ -21,6 +21,8 @@
 #ifndef CRACL_UBLOX_MSG_BASE_HPP
 #define CRACL_UBLOX_MSG_BASE_HPP
 
+#include <cstdint>
+#include <cstring>
 #include <map>
 #include <string>
 #include <vector>
@@ -37,6 +39,78 @@ extern const std::map<std::string,
 
 extern bool valid_checksum(std::vector<uint8_t>& message);
 
+/* @brief Receiver port identifiers, numbered as in CFG-PRT
+ */
+enum port_id { ddc = 0, uart1 = 1, uart2 = 2, usb = 3, spi = 4 };
+
+/* @brief Desired output rate of each message, by class and ID name (e.g.
+ *        profile["NAV"]["CLOCK"] = 1). Rates are per navigation solution, a
+ *        rate of 0 disables the message
+ */
+typedef std::map<std::string, std::map<std::string, uint8_t>> rate_profile;
+
+namespace detail
+{
+
+template <size_t N> struct raw;
+
+template <> struct raw<1> { typedef uint8_t type; };
+template <> struct raw<2> { typedef uint16_t type; };
+template <> struct raw<4> { typedef uint32_t type; };
+template <> struct raw<8> { typedef uint64_t type; };
+
+inline uint8_t byteswap(uint8_t x) { return x; }
+inline uint16_t byteswap(uint16_t x) { return __builtin_bswap16(x); }
+inline uint32_t byteswap(uint32_t x) { return __builtin_bswap32(x); }
+inline uint64_t byteswap(uint64_t x) { return __builtin_bswap64(x); }
+
+} // namespace detail
+
+/* @brief Decode a little endian field of type T starting at an arbitrary
+ *        (possibly unaligned) byte, without type punning the message buffer
+ */
+template <typename T>
+inline T field(const uint8_t* data)
+{
+  typename detail::raw<sizeof (T)>::type x;
+
+  std::memcpy(&x, data, sizeof (T));
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  x = detail::byteswap(x);
+#endif
+
+  T t;
+
+  std::memcpy(&t, &x, sizeof (T));
+
+  return t;
+}
+
+template <typename T>
+inline T field(const std::vector<uint8_t>& message, size_t offset)
+{
+  return field<T>(message.data() + offset);
+}
+
+/* @brief Non-owning view over the bytes of a received UBX message. Fields are
+ *        decoded on access from fixed offsets rather than copied up front, so
+ *        the message must outlive the view and should already have been
+ *        verified with the type() function of the matching parsed class
+ */
+class view
+{
+protected:
+  const uint8_t* m_data;
+
+public:
+  view(const uint8_t* data) : m_data(data) { }
+
+  view(const std::vector<uint8_t>& message) : m_data(message.data()) { }
+
+  const uint8_t* data() const { return m_data; }
+};
+
 } // namespace ubx
 
 } // namespace cracl
@@ -0,0 +1,241 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "cfg.hpp"
+#include "f9.hpp"
+
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace cfg
+{
+
+const key keys[] = {
+  // CFG-NAVSPG
+  {"CFG-NAVSPG-FIXMODE",           0x20110011, E1},
+  {"CFG-NAVSPG-DYNMODEL",          0x20110021, E1},
+  {"CFG-NAVSPG-INFIL_MINSVS",      0x201100a1, U1},
+  {"CFG-NAVSPG-INFIL_MAXSVS",      0x201100a2, U1},
+  {"CFG-NAVSPG-INFIL_MINCNO",      0x201100a3, U1},
+  {"CFG-NAVSPG-INFIL_MINELEV",     0x201100a4, I1},
+  // CFG-RATE
+  {"CFG-RATE-MEAS",                0x30210001, U2},
+  {"CFG-RATE-NAV",                 0x30210002, U2},
+  {"CFG-RATE-TIMEREF",             0x20210003, E1},
+  // CFG-SIGNAL
+  {"CFG-SIGNAL-GPS_L1CA_ENA",      0x10310001, L},
+  {"CFG-SIGNAL-GPS_L2C_ENA",       0x10310003, L},
+  {"CFG-SIGNAL-SBAS_L1CA_ENA",     0x10310005, L},
+  {"CFG-SIGNAL-GAL_E1_ENA",        0x10310007, L},
+  {"CFG-SIGNAL-GAL_E5B_ENA",       0x1031000a, L},
+  {"CFG-SIGNAL-BDS_B1_ENA",        0x1031000d, L},
+  {"CFG-SIGNAL-BDS_B2_ENA",        0x1031000e, L},
+  {"CFG-SIGNAL-QZSS_L1CA_ENA",     0x10310012, L},
+  {"CFG-SIGNAL-QZSS_L2C_ENA",      0x10310015, L},
+  {"CFG-SIGNAL-GLO_L1_ENA",        0x10310018, L},
+  {"CFG-SIGNAL-GLO_L2_ENA",        0x1031001a, L},
+  {"CFG-SIGNAL-GPS_ENA",           0x1031001f, L},
+  {"CFG-SIGNAL-SBAS_ENA",          0x10310020, L},
+  {"CFG-SIGNAL-GAL_ENA",           0x10310021, L},
+  {"CFG-SIGNAL-BDS_ENA",           0x10310022, L},
+  {"CFG-SIGNAL-QZSS_ENA",          0x10310024, L},
+  {"CFG-SIGNAL-GLO_ENA",           0x10310025, L},
+  // CFG-TMODE
+  {"CFG-TMODE-MODE",               0x20030001, E1},
+  {"CFG-TMODE-POS_TYPE",           0x20030002, E1},
+  {"CFG-TMODE-ECEF_X",             0x40030003, I4},
+  {"CFG-TMODE-ECEF_Y",             0x40030004, I4},
+  {"CFG-TMODE-ECEF_Z",             0x40030005, I4},
+  {"CFG-TMODE-ECEF_X_HP",          0x20030006, I1},
+  {"CFG-TMODE-ECEF_Y_HP",          0x20030007, I1},
+  {"CFG-TMODE-ECEF_Z_HP",          0x20030008, I1},
+  {"CFG-TMODE-LAT",                0x40030009, I4},
+  {"CFG-TMODE-LON",                0x4003000a, I4},
+  {"CFG-TMODE-HEIGHT",             0x4003000b, I4},
+  {"CFG-TMODE-LAT_HP",             0x2003000c, I1},
+  {"CFG-TMODE-LON_HP",             0x2003000d, I1},
+  {"CFG-TMODE-HEIGHT_HP",          0x2003000e, I1},
+  {"CFG-TMODE-FIXED_POS_ACC",      0x4003000f, U4},
+  {"CFG-TMODE-SVIN_MIN_DUR",       0x40030010, U4},
+  {"CFG-TMODE-SVIN_ACC_LIMIT",     0x40030011, U4},
+  // CFG-TP
+  {"CFG-TP-ANT_CABLEDELAY",        0x30050001, I2},
+  {"CFG-TP-PERIOD_TP1",            0x40050002, U4},
+  {"CFG-TP-PERIOD_LOCK_TP1",       0x40050003, U4},
+  {"CFG-TP-LEN_TP1",               0x40050004, U4},
+  {"CFG-TP-LEN_LOCK_TP1",          0x40050005, U4},
+  {"CFG-TP-USER_DELAY_TP1",        0x40050006, I4},
+  {"CFG-TP-TP1_ENA",               0x10050007, L},
+  {"CFG-TP-SYNC_GNSS_TP1",         0x10050008, L},
+  {"CFG-TP-USE_LOCKED_TP1",        0x10050009, L},
+  {"CFG-TP-ALIGN_TO_TOW_TP1",      0x1005000a, L},
+  {"CFG-TP-POL_TP1",               0x1005000b, L},
+  {"CFG-TP-TIMEGRID_TP1",          0x2005000c, E1},
+  {"CFG-TP-PULSE_DEF",             0x20050023, E1},
+  {"CFG-TP-FREQ_TP1",              0x40050024, U4},
+  {"CFG-TP-FREQ_LOCK_TP1",         0x40050025, U4},
+  {"CFG-TP-DUTY_TP1",              0x5005002a, R8},
+  {"CFG-TP-DUTY_LOCK_TP1",         0x5005002b, R8},
+  {"CFG-TP-PULSE_LENGTH_DEF",      0x20050030, E1},
+  // CFG-UART1
+  {"CFG-UART1-BAUDRATE",           0x40520001, U4},
+  {"CFG-UART1-STOPBITS",           0x20520002, E1},
+  {"CFG-UART1-DATABITS",           0x20520003, E1},
+  {"CFG-UART1-PARITY",             0x20520004, E1},
+  {"CFG-UART1-ENABLED",            0x10520005, L},
+  // CFG-UART2
+  {"CFG-UART2-BAUDRATE",           0x40530001, U4},
+  {"CFG-UART2-STOPBITS",           0x20530002, E1},
+  {"CFG-UART2-DATABITS",           0x20530003, E1},
+  {"CFG-UART2-PARITY",             0x20530004, E1},
+  {"CFG-UART2-ENABLED",            0x10530005, L},
+  // CFG-*INPROT / CFG-*OUTPROT
+  {"CFG-UART1INPROT-UBX",          0x10730001, L},
+  {"CFG-UART1INPROT-NMEA",         0x10730002, L},
+  {"CFG-UART1INPROT-RTCM3X",       0x10730004, L},
+  {"CFG-UART1OUTPROT-UBX",         0x10740001, L},
+  {"CFG-UART1OUTPROT-NMEA",        0x10740002, L},
+  {"CFG-UART1OUTPROT-RTCM3X",      0x10740004, L},
+  {"CFG-UART2INPROT-UBX",          0x10750001, L},
+  {"CFG-UART2INPROT-NMEA",         0x10750002, L},
+  {"CFG-UART2INPROT-RTCM3X",       0x10750004, L},
+  {"CFG-UART2OUTPROT-UBX",         0x10760001, L},
+  {"CFG-UART2OUTPROT-NMEA",        0x10760002, L},
+  {"CFG-UART2OUTPROT-RTCM3X",      0x10760004, L},
+  {"CFG-USBINPROT-UBX",            0x10770001, L},
+  {"CFG-USBINPROT-NMEA",           0x10770002, L},
+  {"CFG-USBINPROT-RTCM3X",         0x10770004, L},
+  {"CFG-USBOUTPROT-UBX",           0x10780001, L},
+  {"CFG-USBOUTPROT-NMEA",          0x10780002, L},
+  {"CFG-USBOUTPROT-RTCM3X",        0x10780004, L},
+};
+
+const size_t key_count = sizeof (keys) / sizeof (keys[0]);
+
+const key& find(const std::string& name)
+{
+  for (size_t i = 0; i < key_count; ++i)
+    if (name == keys[i].name)
+      return keys[i];
+
+  throw std::runtime_error("Unknown configuration key: " + name);
+}
+
+const key& find(uint32_t id)
+{
+  for (size_t i = 0; i < key_count; ++i)
+    if (keys[i].id == id)
+      return keys[i];
+
+  throw std::runtime_error("Unknown configuration key ID");
+}
+
+uint32_t msgout(const std::string& msg_class, const std::string& msg_id,
+    port_id port)
+{
+  return f9_msgout_map.at(msg_class).at(msg_id) + port;
+}
+
+bool cache::contains(uint32_t id) const
+{
+  return m_values.find(id) != m_values.end();
+}
+
+std::vector<uint32_t> cache::missing(const std::vector<uint32_t>& ids) const
+{
+  std::vector<uint32_t> keys;
+
+  for (uint32_t id : ids)
+    if (!contains(id))
+      keys.push_back(id);
+
+  return keys;
+}
+
+size_t cache::store(std::vector<uint8_t>& message)
+{
+  // Only responses (version 0x01) carry values, polls share the same ID
+  if (message.size() < 12 || message[2] != msg_map.at("CFG").first
+      || message[3] != msg_map.at("CFG").second.at("VALGET")
+      || message[6] != 0x01 || !valid_checksum(message))
+    return 0;
+
+  const size_t end = 6 + field<uint16_t>(message, 4);
+
+  size_t stored = 0;
+
+  // key/value pairs start after version, layer and position
+  for (size_t i = 10; i + 4 <= end; ++stored)
+  {
+    const uint32_t id = field<uint32_t>(message, i);
+    const size_t bytes = size(id);
+
+    i += 4;
+
+    if (bytes == 0 || i + bytes > end)
+      break;
+
+    uint64_t value = 0;
+
+    for (size_t j = 0; j < bytes; ++j)
+      value |= static_cast<uint64_t>(message[i + j]) << (8 * j);
+
+    m_values[id] = value;
+
+    i += bytes;
+  }
+
+  return stored;
+}
+
+void cache::invalidate(uint32_t id)
+{
+  m_values.erase(id);
+}
+
+void cache::clear()
+{
+  m_values.clear();
+}
+
+uint64_t cache::raw(uint32_t id) const
+{
+  auto value = m_values.find(id);
+
+  if (value == m_values.end())
+    throw std::runtime_error("Configuration value not cached");
+
+  return value->second;
+}
+
+} // namespace cfg
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,162 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_MSG_CFG_HPP
+#define CRACL_UBLOX_MSG_CFG_HPP
+
+#include "base.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace cfg
+{
+
+/* @brief Value types used by the F9 configuration interface
+ */
+enum type { L, U1, U2, U4, U8, I1, I2, I4, I8, X1, X2, X4, X8, E1, E2, E4,
+  R4, R8 };
+
+struct key
+{
+  const char* name;
+  uint32_t id;
+  cfg::type type;
+};
+
+/* @brief Number of bytes a value occupies in CFG-VALSET/VALGET, which is
+ *        encoded in bits 28-30 of every key ID
+ */
+constexpr size_t size(uint32_t id)
+{
+  return ((id >> 28) & 0x07) == 0x05 ? 8
+    : ((id >> 28) & 0x07) == 0x04 ? 4
+    : ((id >> 28) & 0x07) == 0x03 ? 2
+    : ((id >> 28) & 0x07) == 0x02 || ((id >> 28) & 0x07) == 0x01 ? 1 : 0;
+}
+
+/* @brief Table of known configuration keys (CFG-MSGOUT keys are derived from
+ *        ubx::f9_msgout_map with msgout() instead)
+ */
+extern const key keys[];
+
+extern const size_t key_count;
+
+/* @brief Look up a key by name (e.g. "CFG-RATE-MEAS") or ID
+ */
+const key& find(const std::string& name);
+
+const key& find(uint32_t id);
+
+/* @brief Key ID of a message output rate on a given port
+ */
+uint32_t msgout(const std::string& msg_class, const std::string& msg_id,
+    port_id port);
+
+/* @brief Local copy of receiver configuration values (RAM layer)
+ *
+ * Values are filled in from CFG-VALGET responses and remain valid until the
+ * key is invalidated, which happens whenever the key is changed through
+ * CFG-VALSET. Only missing keys then need to be queried again.
+ */
+class cache
+{
+  std::map<uint32_t, uint64_t> m_values;
+
+public:
+  bool contains(uint32_t id) const;
+
+  /* @brief Keys from a list which are not currently cached
+   */
+  std::vector<uint32_t> missing(const std::vector<uint32_t>& ids) const;
+
+  /* @brief Store every key/value pair carried by a CFG-VALGET response
+   *
+   * @return Number of values stored
+   */
+  size_t store(std::vector<uint8_t>& message);
+
+  void invalidate(uint32_t id);
+
+  void clear();
+
+  /* @brief Raw value of a key, zero extended to 64 bits
+   */
+  uint64_t raw(uint32_t id) const;
+
+  /* @brief Value of a key converted to T (R4/R8 keys must be read as a
+   *        floating point type)
+   */
+  template <typename T>
+  T value(uint32_t id) const
+  {
+    if (sizeof (T) < size(id))
+      throw std::runtime_error("Type too small for configuration value");
+
+    uint64_t x = raw(id);
+
+    if (std::is_floating_point<T>::value)
+    {
+      if (size(id) == 4)
+      {
+        uint32_t bits = static_cast<uint32_t>(x);
+        float f;
+
+        std::memcpy(&f, &bits, sizeof (f));
+
+        return static_cast<T>(f);
+      }
+
+      double d;
+
+      std::memcpy(&d, &x, sizeof (d));
+
+      return static_cast<T>(d);
+    }
+
+    // Sign extend signed values narrower than 64 bits
+    const size_t bits = 8 * size(id);
+
+    if (std::is_signed<T>::value && bits < 64 && ((x >> (bits - 1)) & 0x01))
+      x |= ~0ULL << bits;
+
+    return static_cast<T>(x);
+  }
+
+}; // ubx::cfg::cache
+
+} // namespace cfg
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_MSG_CFG_HPP
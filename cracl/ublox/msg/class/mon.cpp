@@ -45,13 +45,13 @@ void hw::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_pinSel = (*(reinterpret_cast<uint32_t*> (&message[6])));
-    m_pinBank = (*(reinterpret_cast<uint32_t*> (&message[10])));
-    m_pinDir = (*(reinterpret_cast<uint32_t*> (&message[14])));
-    m_pinVal = (*(reinterpret_cast<uint32_t*> (&message[18])));
+    m_pinSel = field<uint32_t>(message, 6);
+    m_pinBank = field<uint32_t>(message, 10);
+    m_pinDir = field<uint32_t>(message, 14);
+    m_pinVal = field<uint32_t>(message, 18);
 
-    m_noisePerMS = (*(reinterpret_cast<uint16_t*> (&message[22])));
-    m_agcCnt = (*(reinterpret_cast<uint16_t*> (&message[24])));
+    m_noisePerMS = field<uint16_t>(message, 22);
+    m_agcCnt = field<uint16_t>(message, 24);
 
     m_aStatus = message[26];
     m_aPower  = message[27];
@@ -63,15 +63,15 @@ void hw::update(std::vector<uint8_t>& message)
     m_jammingState = bitfield >> 2 & 0x03;
     m_xtalAbsent = bitfield >> 4 & 0x01;
 
-    m_usedMask = (*(reinterpret_cast<uint32_t*> (&message[30])));
+    m_usedMask = field<uint32_t>(message, 30);
 
     std::memcpy(m_vp.data(), &message[34], 17);
 
     m_jamInd = message[51];
 
-    m_pinIrq = (*(reinterpret_cast<uint32_t*> (&message[54])));
-    m_pullH = (*(reinterpret_cast<uint32_t*> (&message[58])));
-    m_pullL = (*(reinterpret_cast<uint32_t*> (&message[62])));
+    m_pinIrq = field<uint32_t>(message, 54);
+    m_pullH = field<uint32_t>(message, 58);
+    m_pullL = field<uint32_t>(message, 62);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -142,7 +142,7 @@ uint32_t hw::usedMask()
   return m_usedMask;
 }
 
-std::array<uint8_t, 17> hw::vp()
+const std::array<uint8_t, 17>& hw::vp()
 {
   return m_vp;
 }
@@ -187,45 +187,42 @@ void rf::update(std::vector<uint8_t>& message)
     m_version = message[6];
     m_nBlocks = message[7];
 
-    m_blockId.clear();
-    m_jammingState.clear();
-    m_antStatus.clear();
-    m_antPower.clear();
-    m_postStatus.clear();
-    m_noisePerMS.clear();
-    m_agcCnt.clear();
-    m_jamInd.clear();
-    m_ofsI.clear();
-    m_magI.clear();
-    m_ofsQ.clear();
-    m_magQ.clear();
+    m_blockId.resize(m_nBlocks);
+    m_jammingState.resize(m_nBlocks);
+    m_antStatus.resize(m_nBlocks);
+    m_antPower.resize(m_nBlocks);
+    m_postStatus.resize(m_nBlocks);
+    m_noisePerMS.resize(m_nBlocks);
+    m_agcCnt.resize(m_nBlocks);
+    m_jamInd.resize(m_nBlocks);
+    m_ofsI.resize(m_nBlocks);
+    m_magI.resize(m_nBlocks);
+    m_ofsQ.resize(m_nBlocks);
+    m_magQ.resize(m_nBlocks);
 
     for (size_t i = 0; i < m_nBlocks; ++i)
     {
-      m_blockId.push_back(message[10 + (i * 24)]);
+      m_blockId[i] = message[10 + (i * 24)];
 
-      m_jammingState.push_back(message[11 + (i * 24)] & 0x03);
+      m_jammingState[i] = message[11 + (i * 24)] & 0x03;
 
-      m_antStatus.push_back(message[12 + (i * 24)]);
-      m_antPower.push_back(message[13 + (i * 24)]);
+      m_antStatus[i] = message[12 + (i * 24)];
+      m_antPower[i] = message[13 + (i * 24)];
 
-      m_postStatus.push_back(
-        *(reinterpret_cast<uint32_t*> (&message[14 + (i * 24)])));
+      m_postStatus[i] = field<uint32_t>(message, 14 + (i * 24));
 
-      m_noisePerMS.push_back(
-        *(reinterpret_cast<uint16_t*> (&message[22 + (i * 24)])));
-      m_agcCnt.push_back(
-        *(reinterpret_cast<uint16_t*> (&message[24 + (i * 24)])));
+      m_noisePerMS[i] = field<uint16_t>(message, 22 + (i * 24));
+      m_agcCnt[i] = field<uint16_t>(message, 24 + (i * 24));
 
-      m_jamInd.push_back(message[26 + (i * 24)]);
+      m_jamInd[i] = message[26 + (i * 24)];
 
-      m_ofsI.push_back(*(reinterpret_cast<int8_t*> (&message[27 + (i * 24)])));
+      m_ofsI[i] = field<int8_t>(message, 27 + (i * 24));
 
-      m_magI.push_back(message[28 + (i * 24)]);
+      m_magI[i] = message[28 + (i * 24)];
 
-      m_ofsQ.push_back(*(reinterpret_cast<int8_t*> (&message[29 + (i * 24)])));
+      m_ofsQ[i] = field<int8_t>(message, 29 + (i * 24));
 
-      m_magQ.push_back(message[20 + (i * 24)]);
+      m_magQ[i] = message[30 + (i * 24)];
     }
   }
   else
@@ -242,61 +239,116 @@ uint8_t rf::nBlocks()
   return m_nBlocks;
 }
 
-std::vector<uint8_t> rf::blockId()
+const std::vector<uint8_t>& rf::blockId()
 {
   return m_blockId;
 }
 
-std::vector<uint8_t> rf::jammingState()
+uint8_t rf::blockId(size_t i)
+{
+  return m_blockId[i];
+}
+
+const std::vector<uint8_t>& rf::jammingState()
 {
   return m_jammingState;
 }
 
-std::vector<uint8_t> rf::antStatus()
+uint8_t rf::jammingState(size_t i)
+{
+  return m_jammingState[i];
+}
+
+const std::vector<uint8_t>& rf::antStatus()
 {
   return m_antStatus;
 }
 
-std::vector<uint32_t> rf::postStatus()
+uint8_t rf::antStatus(size_t i)
+{
+  return m_antStatus[i];
+}
+
+const std::vector<uint32_t>& rf::postStatus()
 {
   return m_postStatus;
 }
 
-std::vector<uint16_t> rf::noisePerMS()
+uint32_t rf::postStatus(size_t i)
+{
+  return m_postStatus[i];
+}
+
+const std::vector<uint16_t>& rf::noisePerMS()
 {
   return m_noisePerMS;
 }
 
-std::vector<uint16_t> rf::agcCnt()
+uint16_t rf::noisePerMS(size_t i)
+{
+  return m_noisePerMS[i];
+}
+
+const std::vector<uint16_t>& rf::agcCnt()
 {
   return m_agcCnt;
 }
 
-std::vector<uint8_t> rf::jamInd()
+uint16_t rf::agcCnt(size_t i)
+{
+  return m_agcCnt[i];
+}
+
+const std::vector<uint8_t>& rf::jamInd()
 {
   return m_jamInd;
 }
 
-std::vector<int8_t> rf::ofsI()
+uint8_t rf::jamInd(size_t i)
+{
+  return m_jamInd[i];
+}
+
+const std::vector<int8_t>& rf::ofsI()
 {
   return m_ofsI;
 }
 
-std::vector<uint8_t> rf::magI()
+int8_t rf::ofsI(size_t i)
+{
+  return m_ofsI[i];
+}
+
+const std::vector<uint8_t>& rf::magI()
 {
   return m_magI;
 }
 
-std::vector<int8_t> rf::ofsQ()
+uint8_t rf::magI(size_t i)
+{
+  return m_magI[i];
+}
+
+const std::vector<int8_t>& rf::ofsQ()
 {
   return m_ofsQ;
 }
 
-std::vector<uint8_t> rf::magQ()
+int8_t rf::ofsQ(size_t i)
+{
+  return m_ofsQ[i];
+}
+
+const std::vector<uint8_t>& rf::magQ()
 {
   return m_magQ;
 }
 
+uint8_t rf::magQ(size_t i)
+{
+  return m_magQ[i];
+}
+
 bool rf::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
@@ -314,39 +366,39 @@ void ver::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    std::array<uint8_t, 30> temp;
-
     std::memcpy(m_swVersion.data(), &message[6], 30);
     std::memcpy(m_hwVersion.data(), &message[36], 10);
 
-    m_extension.clear();
-
-    for (size_t i = 46; i < message.size(); i = i + 30)
-    {
-      std::memcpy(temp.data(), &message[i], 30);
+    // Extensions fill whatever remains between the fixed fields and checksum
+    m_extension.resize((message.size() - 48) / 30);
 
-      m_extension.push_back(temp);
-    }
+    for (size_t i = 0; i < m_extension.size(); ++i)
+      std::memcpy(m_extension[i].data(), &message[46 + (i * 30)], 30);
   }
   else
     throw std::runtime_error("Message type mismatch");
 }
 
-std::array<uint8_t, 30> ver::swVersion()
+const std::array<uint8_t, 30>& ver::swVersion()
 {
   return m_swVersion;
 }
 
-std::array<uint8_t, 10> ver::hwVersion()
+const std::array<uint8_t, 10>& ver::hwVersion()
 {
   return m_hwVersion;
 }
 
-std::vector<std::array<uint8_t, 30>> ver::extension()
+const std::vector<std::array<uint8_t, 30>>& ver::extension()
 {
   return m_extension;
 }
 
+const std::array<uint8_t, 30>& ver::extension(size_t i)
+{
+  return m_extension[i];
+}
+
 bool ver::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
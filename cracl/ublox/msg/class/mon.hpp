@@ -21,6 +21,8 @@
 #ifndef CRACL_UBLOX_MSG_CLASS_MON_HPP
 #define CRACL_UBLOX_MSG_CLASS_MON_HPP
 
+#include "../base.hpp"
+
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -95,7 +97,7 @@ public:
 
   uint32_t usedMask();
 
-  std::array<uint8_t, 17> vp();
+  const std::array<uint8_t, 17>& vp();
 
   uint8_t jamInd();
 
@@ -105,10 +107,57 @@ public:
 
   uint32_t pullL();
 
+  static const char* msg_class() { return "MON"; }
+
+  static const char* msg_id() { return "HW"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::mon::hw
 
+class hw_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t pinSel() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t pinBank() const { return field<uint32_t>(m_data + 10); }
+
+  uint32_t pinDir() const { return field<uint32_t>(m_data + 14); }
+
+  uint32_t pinVal() const { return field<uint32_t>(m_data + 18); }
+
+  uint16_t noisePerMS() const { return field<uint16_t>(m_data + 22); }
+
+  uint16_t agcCnt() const { return field<uint16_t>(m_data + 24); }
+
+  uint8_t aStatus() const { return m_data[26]; }
+
+  uint8_t aPower() const { return m_data[27]; }
+
+  uint8_t rtcCalib() const { return m_data[28] & 0x01; }
+
+  uint8_t safeBoot() const { return m_data[28] >> 1 & 0x01; }
+
+  uint8_t jammingState() const { return m_data[28] >> 2 & 0x03; }
+
+  uint8_t xtalAbsent() const { return m_data[28] >> 4 & 0x01; }
+
+  uint32_t usedMask() const { return field<uint32_t>(m_data + 30); }
+
+  uint8_t vp(size_t i) const { return m_data[34 + i]; }
+
+  uint8_t jamInd() const { return m_data[51]; }
+
+  uint32_t pinIrq() const { return field<uint32_t>(m_data + 54); }
+
+  uint32_t pullH() const { return field<uint32_t>(m_data + 58); }
+
+  uint32_t pullL() const { return field<uint32_t>(m_data + 62); }
+
+}; // ubx::mon::hw_view
+
 class rf
 {
   uint8_t m_version;
@@ -145,27 +194,53 @@ public:
 
   uint8_t nBlocks();
 
-  std::vector<uint8_t> blockId();
+  const std::vector<uint8_t>& blockId();
+
+  uint8_t blockId(size_t i);
+
+  const std::vector<uint8_t>& jammingState();
+
+  uint8_t jammingState(size_t i);
+
+  const std::vector<uint8_t>& antStatus();
+
+  uint8_t antStatus(size_t i);
+
+  const std::vector<uint32_t>& postStatus();
 
-  std::vector<uint8_t> jammingState();
+  uint32_t postStatus(size_t i);
 
-  std::vector<uint8_t> antStatus();
+  const std::vector<uint16_t>& noisePerMS();
 
-  std::vector<uint32_t> postStatus();
+  uint16_t noisePerMS(size_t i);
 
-  std::vector<uint16_t> noisePerMS();
+  const std::vector<uint16_t>& agcCnt();
 
-  std::vector<uint16_t> agcCnt();
+  uint16_t agcCnt(size_t i);
 
-  std::vector<uint8_t> jamInd();
+  const std::vector<uint8_t>& jamInd();
 
-  std::vector<int8_t> ofsI();
+  uint8_t jamInd(size_t i);
 
-  std::vector<uint8_t> magI();
+  const std::vector<int8_t>& ofsI();
 
-  std::vector<int8_t> ofsQ();
+  int8_t ofsI(size_t i);
 
-  std::vector<uint8_t> magQ();
+  const std::vector<uint8_t>& magI();
+
+  uint8_t magI(size_t i);
+
+  const std::vector<int8_t>& ofsQ();
+
+  int8_t ofsQ(size_t i);
+
+  const std::vector<uint8_t>& magQ();
+
+  uint8_t magQ(size_t i);
+
+  static const char* msg_class() { return "MON"; }
+
+  static const char* msg_id() { return "RF"; }
 
   static bool type(std::vector<uint8_t>& message);
 
@@ -185,11 +260,17 @@ public:
 
   void update(std::vector<uint8_t>& message);
 
-  std::array<uint8_t, 30> swVersion();
+  const std::array<uint8_t, 30>& swVersion();
+
+  const std::array<uint8_t, 10>& hwVersion();
+
+  const std::vector<std::array<uint8_t, 30>>& extension();
+
+  const std::array<uint8_t, 30>& extension(size_t i);
 
-  std::array<uint8_t, 10> hwVersion();
+  static const char* msg_class() { return "MON"; }
 
-  std::vector<std::array<uint8_t, 30>> extension();
+  static const char* msg_id() { return "VER"; }
 
   static bool type(std::vector<uint8_t>& message);
 
@@ -45,13 +45,13 @@ void clock::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
-    m_clkB = (*(reinterpret_cast<int32_t*> (&message[10])));
-    m_clkD = (*(reinterpret_cast<int32_t*> (&message[14])));
+    m_clkB = field<int32_t>(message, 10);
+    m_clkD = field<int32_t>(message, 14);
 
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[18])));
-    m_fAcc = (*(reinterpret_cast<uint32_t*> (&message[22])));
+    m_tAcc = field<uint32_t>(message, 18);
+    m_fAcc = field<uint32_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -99,15 +99,15 @@ void dop::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
-
-    m_gDOP = (*(reinterpret_cast<uint16_t*> (&message[10])));
-    m_pDOP = (*(reinterpret_cast<uint16_t*> (&message[12])));
-    m_tDOP = (*(reinterpret_cast<uint16_t*> (&message[14])));
-    m_vDOP = (*(reinterpret_cast<uint16_t*> (&message[16])));
-    m_hDOP = (*(reinterpret_cast<uint16_t*> (&message[18])));
-    m_nDOP = (*(reinterpret_cast<uint16_t*> (&message[20])));
-    m_eDOP = (*(reinterpret_cast<uint16_t*> (&message[22])));
+    m_iTOW = field<uint32_t>(message, 6);
+
+    m_gDOP = field<uint16_t>(message, 10);
+    m_pDOP = field<uint16_t>(message, 12);
+    m_tDOP = field<uint16_t>(message, 14);
+    m_vDOP = field<uint16_t>(message, 16);
+    m_hDOP = field<uint16_t>(message, 18);
+    m_nDOP = field<uint16_t>(message, 20);
+    m_eDOP = field<uint16_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -170,13 +170,13 @@ void posecef::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
-    m_ecefX = (*(reinterpret_cast<int32_t*> (&message[10])));
-    m_ecefY = (*(reinterpret_cast<int32_t*> (&message[14])));
-    m_ecefZ = (*(reinterpret_cast<int32_t*> (&message[18])));
+    m_ecefX = field<int32_t>(message, 10);
+    m_ecefY = field<int32_t>(message, 14);
+    m_ecefZ = field<int32_t>(message, 18);
 
-    m_pAcc = (*(reinterpret_cast<uint32_t*> (&message[22])));
+    m_pAcc = field<uint32_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -224,15 +224,15 @@ void posllh::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
-    m_lon = (*(reinterpret_cast<int32_t*> (&message[10])));
-    m_lat = (*(reinterpret_cast<int32_t*> (&message[14])));
-    m_height = (*(reinterpret_cast<int32_t*> (&message[18])));
-    m_hMSL = (*(reinterpret_cast<int32_t*> (&message[22])));
+    m_lon = field<int32_t>(message, 10);
+    m_lat = field<int32_t>(message, 14);
+    m_height = field<int32_t>(message, 18);
+    m_hMSL = field<int32_t>(message, 22);
 
-    m_hAcc = (*(reinterpret_cast<uint32_t*> (&message[26])));
-    m_vAcc = (*(reinterpret_cast<uint32_t*> (&message[30])));
+    m_hAcc = field<uint32_t>(message, 26);
+    m_vAcc = field<uint32_t>(message, 30);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -290,64 +290,61 @@ void sat::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
     m_version = message[10];
     m_numSvs = message[11];
 
-    m_gnssId.clear();
-    m_svId.clear();
-    m_cno.clear();
-    m_elev.clear();
-    m_azim.clear();
-    m_prRes.clear();
-    m_qualityInd.clear();
-    m_svUsed.clear();
-    m_health.clear();
-    m_diffCorr.clear();
-    m_smoothed.clear();
-    m_orbitSource.clear();
-    m_ephAvail.clear();
-    m_almAvail.clear();
-    m_anoAvail.clear();
-    m_aopAvail.clear();
-    m_sbasCorrUsed.clear();
-    m_rtcmCorrUsed.clear();
-    m_prCorrUsed.clear();
-    m_crCorrUsed.clear();
-    m_doCorrUsed.clear();
+    m_gnssId.resize(m_numSvs);
+    m_svId.resize(m_numSvs);
+    m_cno.resize(m_numSvs);
+    m_elev.resize(m_numSvs);
+    m_azim.resize(m_numSvs);
+    m_prRes.resize(m_numSvs);
+    m_qualityInd.resize(m_numSvs);
+    m_svUsed.resize(m_numSvs);
+    m_health.resize(m_numSvs);
+    m_diffCorr.resize(m_numSvs);
+    m_smoothed.resize(m_numSvs);
+    m_orbitSource.resize(m_numSvs);
+    m_ephAvail.resize(m_numSvs);
+    m_almAvail.resize(m_numSvs);
+    m_anoAvail.resize(m_numSvs);
+    m_aopAvail.resize(m_numSvs);
+    m_sbasCorrUsed.resize(m_numSvs);
+    m_rtcmCorrUsed.resize(m_numSvs);
+    m_prCorrUsed.resize(m_numSvs);
+    m_crCorrUsed.resize(m_numSvs);
+    m_doCorrUsed.resize(m_numSvs);
 
     for (size_t i = 0; i < m_numSvs; ++i)
     {
-      m_gnssId.push_back(message[14 + (i * 12)]);
-      m_svId.push_back(message[15 + (i * 12)]);
-
-      m_cno.push_back(message[16 + (i * 12)]);
-
-      m_elev.push_back(message[17 + (i * 12)]);
-      m_azim.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[18 + (i * 12)])));
-      m_prRes.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[20 + (i * 12)])));
-
-      uint32_t bitfield
-        = (*(reinterpret_cast<uint32_t*> (&message[22 + (i * 12)])));
-
-      m_qualityInd.push_back(bitfield & 0x07);
-      m_svUsed.push_back(bitfield >> 3 & 0x01);
-      m_health.push_back(bitfield >> 4 & 0x03);
-      m_diffCorr.push_back(bitfield >> 6 & 0x01);
-      m_smoothed.push_back(bitfield >> 7 & 0x01);
-      m_orbitSource.push_back(bitfield >> 8 & 0x07);
-      m_ephAvail.push_back(bitfield >> 11 & 0x01);
-      m_almAvail.push_back(bitfield >> 12 & 0x01);
-      m_anoAvail.push_back(bitfield >> 13 & 0x01);
-      m_aopAvail.push_back(bitfield >> 14 & 0x01);
-      m_sbasCorrUsed.push_back(bitfield >> 16 & 0x01);
-      m_rtcmCorrUsed.push_back(bitfield >> 17 & 0x01);
-      m_prCorrUsed.push_back(bitfield >> 20 & 0x01);
-      m_crCorrUsed.push_back(bitfield >> 21 & 0x01);
-      m_doCorrUsed.push_back(bitfield >> 22 & 0x01);
+      m_gnssId[i] = message[14 + (i * 12)];
+      m_svId[i] = message[15 + (i * 12)];
+
+      m_cno[i] = message[16 + (i * 12)];
+
+      m_elev[i] = message[17 + (i * 12)];
+      m_azim[i] = field<int16_t>(message, 18 + (i * 12));
+      m_prRes[i] = field<int16_t>(message, 20 + (i * 12));
+
+      uint32_t bitfield = field<uint32_t>(message, 22 + (i * 12));
+
+      m_qualityInd[i] = bitfield & 0x07;
+      m_svUsed[i] = bitfield >> 3 & 0x01;
+      m_health[i] = bitfield >> 4 & 0x03;
+      m_diffCorr[i] = bitfield >> 6 & 0x01;
+      m_smoothed[i] = bitfield >> 7 & 0x01;
+      m_orbitSource[i] = bitfield >> 8 & 0x07;
+      m_ephAvail[i] = bitfield >> 11 & 0x01;
+      m_almAvail[i] = bitfield >> 12 & 0x01;
+      m_anoAvail[i] = bitfield >> 13 & 0x01;
+      m_aopAvail[i] = bitfield >> 14 & 0x01;
+      m_sbasCorrUsed[i] = bitfield >> 16 & 0x01;
+      m_rtcmCorrUsed[i] = bitfield >> 17 & 0x01;
+      m_prCorrUsed[i] = bitfield >> 20 & 0x01;
+      m_crCorrUsed[i] = bitfield >> 21 & 0x01;
+      m_doCorrUsed[i] = bitfield >> 22 & 0x01;
     }
   }
   else
@@ -369,111 +366,216 @@ uint8_t sat::numSvs()
   return m_numSvs;
 }
 
-std::vector<uint8_t> sat::gnssId()
+const std::vector<uint8_t>& sat::gnssId()
 {
   return m_gnssId;
 }
 
-std::vector<uint8_t> sat::svId()
+uint8_t sat::gnssId(size_t i)
+{
+  return m_gnssId[i];
+}
+
+const std::vector<uint8_t>& sat::svId()
 {
   return m_svId;
 }
 
-std::vector<uint8_t> sat::cno()
+uint8_t sat::svId(size_t i)
+{
+  return m_svId[i];
+}
+
+const std::vector<uint8_t>& sat::cno()
 {
   return m_cno;
 }
 
-std::vector<int8_t> sat::elev()
+uint8_t sat::cno(size_t i)
+{
+  return m_cno[i];
+}
+
+const std::vector<int8_t>& sat::elev()
 {
   return m_elev;
 }
 
-std::vector<int16_t> sat::azim()
+int8_t sat::elev(size_t i)
+{
+  return m_elev[i];
+}
+
+const std::vector<int16_t>& sat::azim()
 {
   return m_azim;
 }
 
-std::vector<int16_t> sat::prRes()
+int16_t sat::azim(size_t i)
+{
+  return m_azim[i];
+}
+
+const std::vector<int16_t>& sat::prRes()
 {
   return m_prRes;
 }
 
-std::vector<uint8_t> sat::qualityInd()
+int16_t sat::prRes(size_t i)
+{
+  return m_prRes[i];
+}
+
+const std::vector<uint8_t>& sat::qualityInd()
 {
   return m_qualityInd;
 }
 
-std::vector<uint8_t> sat::svUsed()
+uint8_t sat::qualityInd(size_t i)
+{
+  return m_qualityInd[i];
+}
+
+const std::vector<uint8_t>& sat::svUsed()
 {
   return m_svUsed;
 }
 
-std::vector<uint8_t> sat::health()
+uint8_t sat::svUsed(size_t i)
+{
+  return m_svUsed[i];
+}
+
+const std::vector<uint8_t>& sat::health()
 {
   return m_health;
 }
 
-std::vector<uint8_t> sat::diffCorr()
+uint8_t sat::health(size_t i)
+{
+  return m_health[i];
+}
+
+const std::vector<uint8_t>& sat::diffCorr()
 {
   return m_diffCorr;
 }
 
-std::vector<uint8_t> sat::smoothed()
+uint8_t sat::diffCorr(size_t i)
+{
+  return m_diffCorr[i];
+}
+
+const std::vector<uint8_t>& sat::smoothed()
 {
   return m_smoothed;
 }
 
-std::vector<uint8_t> sat::orbitSource()
+uint8_t sat::smoothed(size_t i)
+{
+  return m_smoothed[i];
+}
+
+const std::vector<uint8_t>& sat::orbitSource()
 {
   return m_orbitSource;
 }
 
-std::vector<uint8_t> sat::ephAvail()
+uint8_t sat::orbitSource(size_t i)
+{
+  return m_orbitSource[i];
+}
+
+const std::vector<uint8_t>& sat::ephAvail()
 {
   return m_ephAvail;
 }
 
-std::vector<uint8_t> sat::almAvail()
+uint8_t sat::ephAvail(size_t i)
+{
+  return m_ephAvail[i];
+}
+
+const std::vector<uint8_t>& sat::almAvail()
 {
   return m_almAvail;
 }
 
-std::vector<uint8_t> sat::anoAvail()
+uint8_t sat::almAvail(size_t i)
+{
+  return m_almAvail[i];
+}
+
+const std::vector<uint8_t>& sat::anoAvail()
 {
   return m_anoAvail;
 }
 
-std::vector<uint8_t> sat::aopAvail()
+uint8_t sat::anoAvail(size_t i)
+{
+  return m_anoAvail[i];
+}
+
+const std::vector<uint8_t>& sat::aopAvail()
 {
   return m_aopAvail;
 }
 
-std::vector<uint8_t> sat::sbasCorrUsed()
+uint8_t sat::aopAvail(size_t i)
+{
+  return m_aopAvail[i];
+}
+
+const std::vector<uint8_t>& sat::sbasCorrUsed()
 {
   return m_sbasCorrUsed;
 }
 
-std::vector<uint8_t> sat::rtcmCorrUsed()
+uint8_t sat::sbasCorrUsed(size_t i)
+{
+  return m_sbasCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sat::rtcmCorrUsed()
 {
   return m_rtcmCorrUsed;
 }
 
-std::vector<uint8_t> sat::prCorrUsed()
+uint8_t sat::rtcmCorrUsed(size_t i)
+{
+  return m_rtcmCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sat::prCorrUsed()
 {
   return m_prCorrUsed;
 }
 
-std::vector<uint8_t> sat::crCorrUsed()
+uint8_t sat::prCorrUsed(size_t i)
+{
+  return m_prCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sat::crCorrUsed()
 {
   return m_crCorrUsed;
 }
 
-std::vector<uint8_t> sat::doCorrUsed()
+uint8_t sat::crCorrUsed(size_t i)
+{
+  return m_crCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sat::doCorrUsed()
 {
   return m_doCorrUsed;
 }
 
+uint8_t sat::doCorrUsed(size_t i)
+{
+  return m_doCorrUsed[i];
+}
+
 bool sat::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
@@ -491,55 +593,53 @@ void sig::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
     m_version = message[10];
     m_numSigs = message[11];
 
-    m_gnssId.clear();
-    m_svId.clear();
-    m_sigId.clear();
-    m_freqId.clear();
-    m_prRes.clear();
-    m_cno.clear();
-    m_qualityInd.clear();
-    m_corrSource.clear();
-    m_ionoModel.clear();
-    m_health.clear();
-    m_prSmoothed.clear();
-    m_prUsed.clear();
-    m_crUsed.clear();
-    m_doUsed.clear();
-    m_prCorrUsed.clear();
-    m_crCorrUsed.clear();
-    m_doCorrUsed.clear();
+    m_gnssId.resize(m_numSigs);
+    m_svId.resize(m_numSigs);
+    m_sigId.resize(m_numSigs);
+    m_freqId.resize(m_numSigs);
+    m_prRes.resize(m_numSigs);
+    m_cno.resize(m_numSigs);
+    m_qualityInd.resize(m_numSigs);
+    m_corrSource.resize(m_numSigs);
+    m_ionoModel.resize(m_numSigs);
+    m_health.resize(m_numSigs);
+    m_prSmoothed.resize(m_numSigs);
+    m_prUsed.resize(m_numSigs);
+    m_crUsed.resize(m_numSigs);
+    m_doUsed.resize(m_numSigs);
+    m_prCorrUsed.resize(m_numSigs);
+    m_crCorrUsed.resize(m_numSigs);
+    m_doCorrUsed.resize(m_numSigs);
 
     for (size_t i = 0; i < m_numSigs; ++i)
     {
-      m_gnssId.push_back(message[14 + (i * 16)]);
-      m_svId.push_back(message[15 + (i * 16)]);
-      m_sigId.push_back(message[16 + (i * 16)]);
-      m_freqId.push_back(message[17 + (i * 16)]);
-
-      m_prRes.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[18 + (i * 16)])));
-
-      m_cno.push_back(message[20 + (i * 16)]);
-      m_qualityInd.push_back(message[21 + (i * 16)]);
-      m_corrSource.push_back(message[22 + (i * 16)]);
-      m_ionoModel.push_back(message[23 + (i * 16)]);
-
-      uint16_t bitfield
-        = (*(reinterpret_cast<uint16_t*> (&message[18 + (i * 16)])));
-
-      m_health.push_back(bitfield & 0x03);
-      m_prSmoothed.push_back(bitfield >> 2 & 0x01);
-      m_prUsed.push_back(bitfield >> 3 & 0x01);
-      m_crUsed.push_back(bitfield >> 4 & 0x01);
-      m_doUsed.push_back(bitfield >> 5 & 0x01);
-      m_prCorrUsed.push_back(bitfield >> 6 & 0x01);
-      m_crCorrUsed.push_back(bitfield >> 7 & 0x01);
-      m_doCorrUsed.push_back(bitfield >> 8 & 0x01);
+      m_gnssId[i] = message[14 + (i * 16)];
+      m_svId[i] = message[15 + (i * 16)];
+      m_sigId[i] = message[16 + (i * 16)];
+      m_freqId[i] = message[17 + (i * 16)];
+
+      m_prRes[i] = field<int16_t>(message, 18 + (i * 16));
+
+      m_cno[i] = message[20 + (i * 16)];
+      m_qualityInd[i] = message[21 + (i * 16)];
+      m_corrSource[i] = message[22 + (i * 16)];
+      m_ionoModel[i] = message[23 + (i * 16)];
+
+      uint16_t bitfield = field<uint16_t>(message, 24 + (i * 16));
+
+      m_health[i] = bitfield & 0x03;
+      m_prSmoothed[i] = bitfield >> 2 & 0x01;
+      m_prUsed[i] = bitfield >> 3 & 0x01;
+      m_crUsed[i] = bitfield >> 4 & 0x01;
+      m_doUsed[i] = bitfield >> 5 & 0x01;
+      m_prCorrUsed[i] = bitfield >> 6 & 0x01;
+      m_crCorrUsed[i] = bitfield >> 7 & 0x01;
+      m_doCorrUsed[i] = bitfield >> 8 & 0x01;
     }
   }
   else
@@ -561,91 +661,176 @@ uint8_t sig::numSigs()
   return m_numSigs;
 }
 
-std::vector<uint8_t> sig::gnssId()
+const std::vector<uint8_t>& sig::gnssId()
 {
   return m_gnssId;
 }
 
-std::vector<uint8_t> sig::svId()
+uint8_t sig::gnssId(size_t i)
+{
+  return m_gnssId[i];
+}
+
+const std::vector<uint8_t>& sig::svId()
 {
   return m_svId;
 }
 
-std::vector<uint8_t> sig::sigId()
+uint8_t sig::svId(size_t i)
+{
+  return m_svId[i];
+}
+
+const std::vector<uint8_t>& sig::sigId()
 {
   return m_sigId;
 }
 
-std::vector<uint8_t> sig::freqId()
+uint8_t sig::sigId(size_t i)
+{
+  return m_sigId[i];
+}
+
+const std::vector<uint8_t>& sig::freqId()
 {
   return m_freqId;
 }
 
-std::vector<int16_t> sig::prRes()
+uint8_t sig::freqId(size_t i)
+{
+  return m_freqId[i];
+}
+
+const std::vector<int16_t>& sig::prRes()
 {
   return m_prRes;
 }
 
-std::vector<uint8_t> sig::cno()
+int16_t sig::prRes(size_t i)
+{
+  return m_prRes[i];
+}
+
+const std::vector<uint8_t>& sig::cno()
 {
   return m_cno;
 }
 
-std::vector<uint8_t> sig::qualityInd()
+uint8_t sig::cno(size_t i)
+{
+  return m_cno[i];
+}
+
+const std::vector<uint8_t>& sig::qualityInd()
 {
   return m_qualityInd;
 }
 
-std::vector<uint8_t> sig::corrSource()
+uint8_t sig::qualityInd(size_t i)
+{
+  return m_qualityInd[i];
+}
+
+const std::vector<uint8_t>& sig::corrSource()
 {
   return m_corrSource;
 }
 
-std::vector<uint8_t> sig::ionoModel()
+uint8_t sig::corrSource(size_t i)
+{
+  return m_corrSource[i];
+}
+
+const std::vector<uint8_t>& sig::ionoModel()
 {
   return m_ionoModel;
 }
 
-std::vector<uint8_t> sig::health()
+uint8_t sig::ionoModel(size_t i)
+{
+  return m_ionoModel[i];
+}
+
+const std::vector<uint8_t>& sig::health()
 {
   return m_health;
 }
 
-std::vector<uint8_t> sig::prSmoothed()
+uint8_t sig::health(size_t i)
+{
+  return m_health[i];
+}
+
+const std::vector<uint8_t>& sig::prSmoothed()
 {
   return m_prSmoothed;
 }
 
-std::vector<uint8_t> sig::prUsed()
+uint8_t sig::prSmoothed(size_t i)
+{
+  return m_prSmoothed[i];
+}
+
+const std::vector<uint8_t>& sig::prUsed()
 {
   return m_prUsed;
 }
 
-std::vector<uint8_t> sig::crUsed()
+uint8_t sig::prUsed(size_t i)
+{
+  return m_prUsed[i];
+}
+
+const std::vector<uint8_t>& sig::crUsed()
 {
   return m_crUsed;
 }
 
-std::vector<uint8_t> sig::doUsed()
+uint8_t sig::crUsed(size_t i)
+{
+  return m_crUsed[i];
+}
+
+const std::vector<uint8_t>& sig::doUsed()
 {
   return m_doUsed;
 }
 
-std::vector<uint8_t> sig::prCorrUsed()
+uint8_t sig::doUsed(size_t i)
+{
+  return m_doUsed[i];
+}
+
+const std::vector<uint8_t>& sig::prCorrUsed()
 {
   return m_prCorrUsed;
 }
 
-std::vector<uint8_t> sig::crCorrUsed()
+uint8_t sig::prCorrUsed(size_t i)
+{
+  return m_prCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sig::crCorrUsed()
 {
   return m_crCorrUsed;
 }
 
-std::vector<uint8_t> sig::doCorrUsed()
+uint8_t sig::crCorrUsed(size_t i)
+{
+  return m_crCorrUsed[i];
+}
+
+const std::vector<uint8_t>& sig::doCorrUsed()
 {
   return m_doCorrUsed;
 }
 
+uint8_t sig::doCorrUsed(size_t i)
+{
+  return m_doCorrUsed[i];
+}
+
 bool sig::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
@@ -663,7 +848,7 @@ void status::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
     m_gpsFix = message[10];
 
@@ -678,9 +863,9 @@ void status::update(std::vector<uint8_t>& message)
     m_psmState = message[13] & 0x03;
     m_spoofDetState = message[13] >> 3 & 0x03;
 
-    m_ttff = (*(reinterpret_cast<uint32_t*> (&message[14])));
+    m_ttff = field<uint32_t>(message, 14);
 
-    m_msss = (*(reinterpret_cast<uint32_t*> (&message[18])));
+    m_msss = field<uint32_t>(message, 18);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -763,20 +948,20 @@ void timebds::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
-    m_SOW = (*(reinterpret_cast<uint32_t*> (&message[10])));
+    m_iTOW = field<uint32_t>(message, 6);
+    m_SOW = field<uint32_t>(message, 10);
 
-    m_fSOW = (*(reinterpret_cast<int32_t*> (&message[14])));
+    m_fSOW = field<int32_t>(message, 14);
 
-    m_week = (*(reinterpret_cast<int16_t*> (&message[18])));
+    m_week = field<int16_t>(message, 18);
 
-    m_leapS = (*(reinterpret_cast<int8_t*> (&message[20])));
+    m_leapS = field<int8_t>(message, 20);
 
     m_sowValid = message[21] & 0x01;
     m_weekValid = message[21] >> 1 & 0x01;
     m_leapSValid = message[21] >> 2 & 0x01;
 
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[22])));
+    m_tAcc = field<uint32_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -844,20 +1029,20 @@ void timegal::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
-    m_galTow = (*(reinterpret_cast<uint32_t*> (&message[10])));
+    m_iTOW = field<uint32_t>(message, 6);
+    m_galTow = field<uint32_t>(message, 10);
 
-    m_fGalTow = (*(reinterpret_cast<int32_t*> (&message[14])));
+    m_fGalTow = field<int32_t>(message, 14);
 
-    m_galWno = (*(reinterpret_cast<int16_t*> (&message[18])));
+    m_galWno = field<int16_t>(message, 18);
 
-    m_leapS = (*(reinterpret_cast<int8_t*> (&message[20])));
+    m_leapS = field<int8_t>(message, 20);
 
     m_galTowValid = message[21] & 0x01;
     m_galWnoValid = message[21] >> 1 & 0x01;
     m_leapSValid = message[21] >> 2 & 0x01;
 
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[22])));
+    m_tAcc = field<uint32_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -925,19 +1110,19 @@ void timeglo::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
-    m_TOD = (*(reinterpret_cast<uint32_t*> (&message[10])));
+    m_iTOW = field<uint32_t>(message, 6);
+    m_TOD = field<uint32_t>(message, 10);
 
-    m_fTOD = (*(reinterpret_cast<int32_t*> (&message[14])));
+    m_fTOD = field<int32_t>(message, 14);
 
-    m_Nt = (*(reinterpret_cast<uint16_t*> (&message[18])));
+    m_Nt = field<uint16_t>(message, 18);
 
     m_N4 = message[20];
 
     m_todValid = message[21] & 0x01;
     m_dateValid = message[21] >> 1 & 0x01;
 
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[22])));
+    m_tAcc = field<uint32_t>(message, 22);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -1000,19 +1185,19 @@ void timegps::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
+    m_iTOW = field<uint32_t>(message, 6);
 
-    m_fTOD = (*(reinterpret_cast<int32_t*> (&message[10])));
+    m_fTOD = field<int32_t>(message, 10);
 
-    m_week = (*(reinterpret_cast<int16_t*> (&message[14])));
+    m_week = field<int16_t>(message, 14);
 
-    m_leapS = (*(reinterpret_cast<int8_t*> (&message[16])));
+    m_leapS = field<int8_t>(message, 16);
 
     m_towValid = message[17] & 0x01;
     m_weekValid = message[17] >> 1 & 0x01;
     m_leapSValid = message[17] >> 2 & 0x01;
 
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[18])));
+    m_tAcc = field<uint32_t>(message, 18);
   }
   else
     throw std::runtime_error("Message type mismatch");
@@ -1066,6 +1251,94 @@ bool timegps::type(std::vector<uint8_t>& message)
       && message[3] == ubx::msg_map.at("NAV").second.at("TIMEGPS"));
 }
 
+timels::timels(std::vector<uint8_t>& message)
+{
+  update(message);
+}
+
+void timels::update(std::vector<uint8_t>& message)
+{
+  if (type(message))
+  {
+    m_iTOW = field<uint32_t>(message, 6);
+    m_version = message[10];
+    m_srcOfCurrLs = message[14];
+    m_currLs = field<int8_t>(message, 15);
+    m_srcOfLsChange = message[16];
+    m_lsChange = field<int8_t>(message, 17);
+    m_timeToLsEvent = field<int32_t>(message, 18);
+    m_dateOfLsGpsWn = field<uint16_t>(message, 22);
+    m_dateOfLsGpsDn = field<uint16_t>(message, 24);
+    m_validCurrLs = message[29] & 0x01;
+    m_validTimeToLsEvent = message[29] >> 1 & 0x01;
+  }
+  else
+    throw std::runtime_error("Message type mismatch");
+}
+
+uint32_t timels::iTOW()
+{
+  return m_iTOW;
+}
+
+uint8_t timels::version()
+{
+  return m_version;
+}
+
+uint8_t timels::srcOfCurrLs()
+{
+  return m_srcOfCurrLs;
+}
+
+int8_t timels::currLs()
+{
+  return m_currLs;
+}
+
+uint8_t timels::srcOfLsChange()
+{
+  return m_srcOfLsChange;
+}
+
+int8_t timels::lsChange()
+{
+  return m_lsChange;
+}
+
+int32_t timels::timeToLsEvent()
+{
+  return m_timeToLsEvent;
+}
+
+uint16_t timels::dateOfLsGpsWn()
+{
+  return m_dateOfLsGpsWn;
+}
+
+uint16_t timels::dateOfLsGpsDn()
+{
+  return m_dateOfLsGpsDn;
+}
+
+uint8_t timels::validCurrLs()
+{
+  return m_validCurrLs;
+}
+
+uint8_t timels::validTimeToLsEvent()
+{
+  return m_validTimeToLsEvent;
+}
+
+bool timels::type(std::vector<uint8_t>& message)
+{
+  return (!message.empty()
+      && valid_checksum(message)
+      && message[2] == ubx::msg_map.at("NAV").first
+      && message[3] == ubx::msg_map.at("NAV").second.at("TIMELS"));
+}
+
 timeutc::timeutc(std::vector<uint8_t>& message)
 {
   update(message);
@@ -1075,12 +1348,12 @@ void timeutc::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_iTOW = (*(reinterpret_cast<uint32_t*> (&message[6])));
-    m_tAcc = (*(reinterpret_cast<uint32_t*> (&message[10])));
+    m_iTOW = field<uint32_t>(message, 6);
+    m_tAcc = field<uint32_t>(message, 10);
 
-    m_nano = (*(reinterpret_cast<int32_t*> (&message[14])));
+    m_nano = field<int32_t>(message, 14);
 
-    m_year = (*(reinterpret_cast<uint16_t*> (&message[18])));
+    m_year = field<uint16_t>(message, 18);
 
     m_month = message[20];
     m_day = message[21];
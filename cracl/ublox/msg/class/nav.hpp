@@ -22,6 +22,8 @@
 #ifndef CRACL_UBLOX_MSG_CLASS_NAV_HPP
 #define CRACL_UBLOX_MSG_CLASS_NAV_HPP
 
+#include "../base.hpp"
+
 #include <cstdint>
 #include <vector>
 
@@ -61,10 +63,31 @@ public:
 
   uint32_t fAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "CLOCK"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::clock
 
+class clock_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  int32_t clkB() const { return field<int32_t>(m_data + 10); }
+
+  int32_t clkD() const { return field<int32_t>(m_data + 14); }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 18); }
+
+  uint32_t fAcc() const { return field<uint32_t>(m_data + 22); }
+
+}; // ubx::nav::clock_view
+
 class dop
 {
   uint32_t m_iTOW;
@@ -100,10 +123,37 @@ public:
 
   uint16_t eDOP();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "DOP"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::dop
 
+class dop_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint16_t gDOP() const { return field<uint16_t>(m_data + 10); }
+
+  uint16_t pDOP() const { return field<uint16_t>(m_data + 12); }
+
+  uint16_t tDOP() const { return field<uint16_t>(m_data + 14); }
+
+  uint16_t vDOP() const { return field<uint16_t>(m_data + 16); }
+
+  uint16_t hDOP() const { return field<uint16_t>(m_data + 18); }
+
+  uint16_t nDOP() const { return field<uint16_t>(m_data + 20); }
+
+  uint16_t eDOP() const { return field<uint16_t>(m_data + 22); }
+
+}; // ubx::nav::dop_view
+
 class posecef
 {
   uint32_t m_iTOW;
@@ -131,10 +181,31 @@ public:
 
   uint32_t pAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "POSECEF"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::posecef
 
+class posecef_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  int32_t ecefX() const { return field<int32_t>(m_data + 10); }
+
+  int32_t ecefY() const { return field<int32_t>(m_data + 14); }
+
+  int32_t ecefZ() const { return field<int32_t>(m_data + 18); }
+
+  uint32_t pAcc() const { return field<uint32_t>(m_data + 22); }
+
+}; // ubx::nav::posecef_view
+
 class posllh
 {
   uint32_t m_iTOW;
@@ -168,10 +239,35 @@ public:
 
   uint32_t vAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "POSLLH"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::posllh
 
+class posllh_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  int32_t lon() const { return field<int32_t>(m_data + 10); }
+
+  int32_t lat() const { return field<int32_t>(m_data + 14); }
+
+  int32_t height() const { return field<int32_t>(m_data + 18); }
+
+  int32_t hMSL() const { return field<int32_t>(m_data + 22); }
+
+  uint32_t hAcc() const { return field<uint32_t>(m_data + 26); }
+
+  uint32_t vAcc() const { return field<uint32_t>(m_data + 30); }
+
+}; // ubx::nav::posllh_view
+
 class sat
 {
   uint32_t m_iTOW;
@@ -217,52 +313,164 @@ public:
 
   uint8_t numSvs();
 
-  std::vector<uint8_t> gnssId();
+  const std::vector<uint8_t>& gnssId();
+
+  uint8_t gnssId(size_t i);
+
+  const std::vector<uint8_t>& svId();
+
+  uint8_t svId(size_t i);
+
+  const std::vector<uint8_t>& cno();
+
+  uint8_t cno(size_t i);
+
+  const std::vector<int8_t>& elev();
+
+  int8_t elev(size_t i);
+
+  const std::vector<int16_t>& azim();
+
+  int16_t azim(size_t i);
+
+  const std::vector<int16_t>& prRes();
+
+  int16_t prRes(size_t i);
+
+  const std::vector<uint8_t>& qualityInd();
+
+  uint8_t qualityInd(size_t i);
+
+  const std::vector<uint8_t>& svUsed();
+
+  uint8_t svUsed(size_t i);
+
+  const std::vector<uint8_t>& health();
+
+  uint8_t health(size_t i);
+
+  const std::vector<uint8_t>& diffCorr();
+
+  uint8_t diffCorr(size_t i);
+
+  const std::vector<uint8_t>& smoothed();
+
+  uint8_t smoothed(size_t i);
+
+  const std::vector<uint8_t>& orbitSource();
+
+  uint8_t orbitSource(size_t i);
 
-  std::vector<uint8_t> svId();
+  const std::vector<uint8_t>& ephAvail();
 
-  std::vector<uint8_t> cno();
+  uint8_t ephAvail(size_t i);
 
-  std::vector<int8_t> elev();
+  const std::vector<uint8_t>& almAvail();
 
-  std::vector<int16_t> azim();
+  uint8_t almAvail(size_t i);
 
-  std::vector<int16_t> prRes();
+  const std::vector<uint8_t>& anoAvail();
 
-  std::vector<uint8_t> qualityInd();
+  uint8_t anoAvail(size_t i);
 
-  std::vector<uint8_t> svUsed();
+  const std::vector<uint8_t>& aopAvail();
 
-  std::vector<uint8_t> health();
+  uint8_t aopAvail(size_t i);
 
-  std::vector<uint8_t> diffCorr();
+  const std::vector<uint8_t>& sbasCorrUsed();
 
-  std::vector<uint8_t> smoothed();
+  uint8_t sbasCorrUsed(size_t i);
 
-  std::vector<uint8_t> orbitSource();
+  const std::vector<uint8_t>& rtcmCorrUsed();
 
-  std::vector<uint8_t> ephAvail();
+  uint8_t rtcmCorrUsed(size_t i);
 
-  std::vector<uint8_t> almAvail();
+  const std::vector<uint8_t>& prCorrUsed();
 
-  std::vector<uint8_t> anoAvail();
+  uint8_t prCorrUsed(size_t i);
 
-  std::vector<uint8_t> aopAvail();
+  const std::vector<uint8_t>& crCorrUsed();
 
-  std::vector<uint8_t> sbasCorrUsed();
+  uint8_t crCorrUsed(size_t i);
 
-  std::vector<uint8_t> rtcmCorrUsed();
+  const std::vector<uint8_t>& doCorrUsed();
 
-  std::vector<uint8_t> prCorrUsed();
+  uint8_t doCorrUsed(size_t i);
 
-  std::vector<uint8_t> crCorrUsed();
+  static const char* msg_class() { return "NAV"; }
 
-  std::vector<uint8_t> doCorrUsed();
+  static const char* msg_id() { return "SAT"; }
 
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::sat
 
+class sat_view : public view
+{
+  uint32_t flags(size_t i) const
+  {
+    return field<uint32_t>(m_data + 22 + (i * 12));
+  }
+
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint8_t version() const { return m_data[10]; }
+
+  uint8_t numSvs() const { return m_data[11]; }
+
+  uint8_t gnssId(size_t i) const { return m_data[14 + (i * 12)]; }
+
+  uint8_t svId(size_t i) const { return m_data[15 + (i * 12)]; }
+
+  uint8_t cno(size_t i) const { return m_data[16 + (i * 12)]; }
+
+  int8_t elev(size_t i) const { return field<int8_t>(m_data + 17 + (i * 12)); }
+
+  int16_t azim(size_t i) const
+  {
+    return field<int16_t>(m_data + 18 + (i * 12));
+  }
+
+  int16_t prRes(size_t i) const
+  {
+    return field<int16_t>(m_data + 20 + (i * 12));
+  }
+
+  uint8_t qualityInd(size_t i) const { return flags(i) & 0x07; }
+
+  uint8_t svUsed(size_t i) const { return flags(i) >> 3 & 0x01; }
+
+  uint8_t health(size_t i) const { return flags(i) >> 4 & 0x03; }
+
+  uint8_t diffCorr(size_t i) const { return flags(i) >> 6 & 0x01; }
+
+  uint8_t smoothed(size_t i) const { return flags(i) >> 7 & 0x01; }
+
+  uint8_t orbitSource(size_t i) const { return flags(i) >> 8 & 0x07; }
+
+  uint8_t ephAvail(size_t i) const { return flags(i) >> 11 & 0x01; }
+
+  uint8_t almAvail(size_t i) const { return flags(i) >> 12 & 0x01; }
+
+  uint8_t anoAvail(size_t i) const { return flags(i) >> 13 & 0x01; }
+
+  uint8_t aopAvail(size_t i) const { return flags(i) >> 14 & 0x01; }
+
+  uint8_t sbasCorrUsed(size_t i) const { return flags(i) >> 16 & 0x01; }
+
+  uint8_t rtcmCorrUsed(size_t i) const { return flags(i) >> 17 & 0x01; }
+
+  uint8_t prCorrUsed(size_t i) const { return flags(i) >> 20 & 0x01; }
+
+  uint8_t crCorrUsed(size_t i) const { return flags(i) >> 21 & 0x01; }
+
+  uint8_t doCorrUsed(size_t i) const { return flags(i) >> 22 & 0x01; }
+
+}; // ubx::nav::sat_view
+
 class sig
 {
   uint32_t m_iTOW;
@@ -304,44 +512,137 @@ public:
 
   uint8_t numSigs();
 
-  std::vector<uint8_t> gnssId();
+  const std::vector<uint8_t>& gnssId();
+
+  uint8_t gnssId(size_t i);
+
+  const std::vector<uint8_t>& svId();
+
+  uint8_t svId(size_t i);
+
+  const std::vector<uint8_t>& sigId();
+
+  uint8_t sigId(size_t i);
+
+  const std::vector<uint8_t>& freqId();
+
+  uint8_t freqId(size_t i);
 
-  std::vector<uint8_t> svId();
+  const std::vector<int16_t>& prRes();
 
-  std::vector<uint8_t> sigId();
+  int16_t prRes(size_t i);
 
-  std::vector<uint8_t> freqId();
+  const std::vector<uint8_t>& cno();
 
-  std::vector<int16_t> prRes();
+  uint8_t cno(size_t i);
 
-  std::vector<uint8_t> cno();
+  const std::vector<uint8_t>& qualityInd();
 
-  std::vector<uint8_t> qualityInd();
+  uint8_t qualityInd(size_t i);
 
-  std::vector<uint8_t> corrSource();
+  const std::vector<uint8_t>& corrSource();
 
-  std::vector<uint8_t> ionoModel();
+  uint8_t corrSource(size_t i);
 
-  std::vector<uint8_t> health();
+  const std::vector<uint8_t>& ionoModel();
 
-  std::vector<uint8_t> prSmoothed();
+  uint8_t ionoModel(size_t i);
 
-  std::vector<uint8_t> prUsed();
+  const std::vector<uint8_t>& health();
 
-  std::vector<uint8_t> crUsed();
+  uint8_t health(size_t i);
 
-  std::vector<uint8_t> doUsed();
+  const std::vector<uint8_t>& prSmoothed();
 
-  std::vector<uint8_t> prCorrUsed();
+  uint8_t prSmoothed(size_t i);
 
-  std::vector<uint8_t> crCorrUsed();
+  const std::vector<uint8_t>& prUsed();
 
-  std::vector<uint8_t> doCorrUsed();
+  uint8_t prUsed(size_t i);
+
+  const std::vector<uint8_t>& crUsed();
+
+  uint8_t crUsed(size_t i);
+
+  const std::vector<uint8_t>& doUsed();
+
+  uint8_t doUsed(size_t i);
+
+  const std::vector<uint8_t>& prCorrUsed();
+
+  uint8_t prCorrUsed(size_t i);
+
+  const std::vector<uint8_t>& crCorrUsed();
+
+  uint8_t crCorrUsed(size_t i);
+
+  const std::vector<uint8_t>& doCorrUsed();
+
+  uint8_t doCorrUsed(size_t i);
+
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "SIG"; }
 
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::sig
 
+class sig_view : public view
+{
+  uint16_t flags(size_t i) const
+  {
+    return field<uint16_t>(m_data + 24 + (i * 16));
+  }
+
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint8_t version() const { return m_data[10]; }
+
+  uint8_t numSigs() const { return m_data[11]; }
+
+  uint8_t gnssId(size_t i) const { return m_data[14 + (i * 16)]; }
+
+  uint8_t svId(size_t i) const { return m_data[15 + (i * 16)]; }
+
+  uint8_t sigId(size_t i) const { return m_data[16 + (i * 16)]; }
+
+  uint8_t freqId(size_t i) const { return m_data[17 + (i * 16)]; }
+
+  int16_t prRes(size_t i) const
+  {
+    return field<int16_t>(m_data + 18 + (i * 16));
+  }
+
+  uint8_t cno(size_t i) const { return m_data[20 + (i * 16)]; }
+
+  uint8_t qualityInd(size_t i) const { return m_data[21 + (i * 16)]; }
+
+  uint8_t corrSource(size_t i) const { return m_data[22 + (i * 16)]; }
+
+  uint8_t ionoModel(size_t i) const { return m_data[23 + (i * 16)]; }
+
+  uint8_t health(size_t i) const { return flags(i) & 0x03; }
+
+  uint8_t prSmoothed(size_t i) const { return flags(i) >> 2 & 0x01; }
+
+  uint8_t prUsed(size_t i) const { return flags(i) >> 3 & 0x01; }
+
+  uint8_t crUsed(size_t i) const { return flags(i) >> 4 & 0x01; }
+
+  uint8_t doUsed(size_t i) const { return flags(i) >> 5 & 0x01; }
+
+  uint8_t prCorrUsed(size_t i) const { return flags(i) >> 6 & 0x01; }
+
+  uint8_t crCorrUsed(size_t i) const { return flags(i) >> 7 & 0x01; }
+
+  uint8_t doCorrUsed(size_t i) const { return flags(i) >> 8 & 0x01; }
+
+}; // ubx::nav::sig_view
+
 class status
 {
   uint32_t m_iTOW;
@@ -390,10 +691,45 @@ public:
 
   uint32_t msss();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "STATUS"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::status
 
+class status_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint8_t gpsFix() const { return m_data[10]; }
+
+  uint8_t gpsFixOk() const { return m_data[11] & 0x01; }
+
+  uint8_t diffSoln() const { return m_data[11] >> 1 & 0x01; }
+
+  uint8_t wknSet() const { return m_data[11] >> 2 & 0x01; }
+
+  uint8_t towSet() const { return m_data[11] >> 3 & 0x01; }
+
+  uint8_t diffCorr() const { return m_data[12] & 0x01; }
+
+  uint8_t mapMatching() const { return m_data[12] >> 6 & 0x03; }
+
+  uint8_t psmState() const { return m_data[13] & 0x03; }
+
+  uint8_t spoofDetState() const { return m_data[13] >> 3 & 0x03; }
+
+  uint32_t ttff() const { return field<uint32_t>(m_data + 14); }
+
+  uint32_t msss() const { return field<uint32_t>(m_data + 18); }
+
+}; // ubx::nav::status_view
+
 class timebds
 {
   uint32_t m_iTOW;
@@ -436,10 +772,39 @@ public:
 
   uint32_t tAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMEBDS"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::timebds
 
+class timebds_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t sow() const { return field<uint32_t>(m_data + 10); }
+
+  int32_t fSOW() const { return field<int32_t>(m_data + 14); }
+
+  int16_t week() const { return field<int16_t>(m_data + 18); }
+
+  int8_t leapS() const { return field<int8_t>(m_data + 20); }
+
+  uint8_t sowValid() const { return m_data[21] & 0x01; }
+
+  uint8_t weekValid() const { return m_data[21] >> 1 & 0x01; }
+
+  uint8_t leapSValid() const { return m_data[21] >> 2 & 0x01; }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 22); }
+
+}; // ubx::nav::timebds_view
+
 class timegal
 {
   uint32_t m_iTOW;
@@ -482,10 +847,39 @@ public:
 
   uint32_t tAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMEGAL"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::timegal
 
+class timegal_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t galTow() const { return field<uint32_t>(m_data + 10); }
+
+  int32_t fGalTow() const { return field<int32_t>(m_data + 14); }
+
+  int16_t galWno() const { return field<int16_t>(m_data + 18); }
+
+  int8_t leapS() const { return field<int8_t>(m_data + 20); }
+
+  uint8_t galTowValid() const { return m_data[21] & 0x01; }
+
+  uint8_t galWnoValid() const { return m_data[21] >> 1 & 0x01; }
+
+  uint8_t leapSValid() const { return m_data[21] >> 2 & 0x01; }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 22); }
+
+}; // ubx::nav::timegal_view
+
 class timeglo
 {
   uint32_t m_iTOW;
@@ -524,10 +918,37 @@ public:
 
   uint32_t tAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMEGLO"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::timeglo
 
+class timeglo_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t tod() const { return field<uint32_t>(m_data + 10); }
+
+  int32_t fTOD() const { return field<int32_t>(m_data + 14); }
+
+  uint16_t nt() const { return field<uint16_t>(m_data + 18); }
+
+  uint8_t n4() const { return m_data[20]; }
+
+  uint8_t todValid() const { return m_data[21] & 0x01; }
+
+  uint8_t dateValid() const { return m_data[21] >> 1 & 0x01; }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 22); }
+
+}; // ubx::nav::timeglo_view
+
 class timegps
 {
   uint32_t m_iTOW;
@@ -567,10 +988,124 @@ public:
 
   uint32_t tAcc();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMEGPS"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::timegps
 
+class timegps_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  int32_t fTOD() const { return field<int32_t>(m_data + 10); }
+
+  int16_t week() const { return field<int16_t>(m_data + 14); }
+
+  int8_t leapS() const { return field<int8_t>(m_data + 16); }
+
+  uint8_t towValid() const { return m_data[17] & 0x01; }
+
+  uint8_t weekValid() const { return m_data[17] >> 1 & 0x01; }
+
+  uint8_t leapSValid() const { return m_data[17] >> 2 & 0x01; }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 18); }
+
+}; // ubx::nav::timegps_view
+
+class timels
+{
+  uint32_t m_iTOW;
+
+  uint8_t m_version;
+  uint8_t m_srcOfCurrLs;
+
+  int8_t m_currLs;
+
+  uint8_t m_srcOfLsChange;
+
+  int8_t m_lsChange;
+
+  int32_t m_timeToLsEvent;
+
+  uint16_t m_dateOfLsGpsWn;
+  uint16_t m_dateOfLsGpsDn;
+
+  uint8_t m_validCurrLs;
+  uint8_t m_validTimeToLsEvent;
+
+public:
+  timels(){ }
+
+  timels(std::vector<uint8_t>& message);
+
+  void update(std::vector<uint8_t>& message);
+
+  uint32_t iTOW();
+
+  uint8_t version();
+
+  uint8_t srcOfCurrLs();
+
+  int8_t currLs();
+
+  uint8_t srcOfLsChange();
+
+  int8_t lsChange();
+
+  int32_t timeToLsEvent();
+
+  uint16_t dateOfLsGpsWn();
+
+  uint16_t dateOfLsGpsDn();
+
+  uint8_t validCurrLs();
+
+  uint8_t validTimeToLsEvent();
+
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMELS"; }
+
+  static bool type(std::vector<uint8_t>& message);
+
+}; // ubx::nav::timels
+
+class timels_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint8_t version() const { return m_data[10]; }
+
+  uint8_t srcOfCurrLs() const { return m_data[14]; }
+
+  int8_t currLs() const { return field<int8_t>(m_data + 15); }
+
+  uint8_t srcOfLsChange() const { return m_data[16]; }
+
+  int8_t lsChange() const { return field<int8_t>(m_data + 17); }
+
+  int32_t timeToLsEvent() const { return field<int32_t>(m_data + 18); }
+
+  uint16_t dateOfLsGpsWn() const { return field<uint16_t>(m_data + 22); }
+
+  uint16_t dateOfLsGpsDn() const { return field<uint16_t>(m_data + 24); }
+
+  uint8_t validCurrLs() const { return m_data[29] & 0x01; }
+
+  uint8_t validTimeToLsEvent() const { return m_data[29] >> 1 & 0x01; }
+
+}; // ubx::nav::timels_view
+
 class timeutc
 {
   uint32_t m_iTOW;
@@ -624,10 +1159,47 @@ public:
 
   uint8_t utcStandard();
 
+  static const char* msg_class() { return "NAV"; }
+
+  static const char* msg_id() { return "TIMEUTC"; }
+
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::nav::timeutc
 
+class timeutc_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t iTOW() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t tAcc() const { return field<uint32_t>(m_data + 10); }
+
+  int32_t nano() const { return field<int32_t>(m_data + 14); }
+
+  uint16_t year() const { return field<uint16_t>(m_data + 18); }
+
+  uint8_t month() const { return m_data[20]; }
+
+  uint8_t day() const { return m_data[21]; }
+
+  uint8_t hour() const { return m_data[22]; }
+
+  uint8_t min() const { return m_data[23]; }
+
+  uint8_t sec() const { return m_data[24]; }
+
+  uint8_t validTOW() const { return m_data[25] & 0x01; }
+
+  uint8_t validWKN() const { return m_data[25] >> 1 & 0x01; }
+
+  uint8_t validUTC() const { return m_data[25] >> 2 & 0x01; }
+
+  uint8_t utcStandard() const { return m_data[25] >> 4 & 0x0f; }
+
+}; // ubx::nav::timeutc_view
+
 } // namespace nav
 
 } // namespace ubx
@@ -46,53 +46,48 @@ void measx::update(std::vector<uint8_t>& message)
   {
     m_version = message[6];
 
-    m_gpsTOW = (*(reinterpret_cast<uint32_t*> (&message[10])));
-    m_gloTOW = (*(reinterpret_cast<uint32_t*> (&message[14])));
-    m_bdsTOW = (*(reinterpret_cast<uint32_t*> (&message[18])));
-    m_qzssTOW = (*(reinterpret_cast<uint32_t*> (&message[36])));
+    m_gpsTOW = field<uint32_t>(message, 10);
+    m_gloTOW = field<uint32_t>(message, 14);
+    m_bdsTOW = field<uint32_t>(message, 18);
+    m_qzssTOW = field<uint32_t>(message, 26);
 
-    m_gpsTOWacc = (*(reinterpret_cast<uint16_t*> (&message[30])));
-    m_gloTOWacc = (*(reinterpret_cast<uint16_t*> (&message[32])));
-    m_bdsTOWacc = (*(reinterpret_cast<uint16_t*> (&message[34])));
-    m_qzssTOWacc = (*(reinterpret_cast<uint16_t*> (&message[38])));
+    m_gpsTOWacc = field<uint16_t>(message, 30);
+    m_gloTOWacc = field<uint16_t>(message, 32);
+    m_bdsTOWacc = field<uint16_t>(message, 34);
+    m_qzssTOWacc = field<uint16_t>(message, 38);
 
     m_numSV = message[40];
     m_towSet = message[41] & 0x03;
 
-    m_gnssId.clear();
-    m_svId.clear();
-    m_cNo.clear();
-    m_mpathIndic.clear();
-    m_dopplerMS.clear();
-    m_dopplerHz.clear();
-    m_wholeChips.clear();
-    m_fracChips.clear();
-    m_codePhase.clear();
-    m_intCodePhase.clear();
-    m_pseuRangeRMSErr.clear();
+    m_gnssId.resize(m_numSV);
+    m_svId.resize(m_numSV);
+    m_cNo.resize(m_numSV);
+    m_mpathIndic.resize(m_numSV);
+    m_dopplerMS.resize(m_numSV);
+    m_dopplerHz.resize(m_numSV);
+    m_wholeChips.resize(m_numSV);
+    m_fracChips.resize(m_numSV);
+    m_codePhase.resize(m_numSV);
+    m_intCodePhase.resize(m_numSV);
+    m_pseuRangeRMSErr.resize(m_numSV);
 
     for (size_t i = 0; i < m_numSV; ++i)
     {
-      m_gnssId.push_back(message[50 + (i * 24)]);
-      m_svId.push_back(message[51 + (i * 24)]);
-      m_cNo.push_back(message[52 + (i * 24)]);
-      m_mpathIndic.push_back(message[53 + (i * 24)]);
-
-      m_dopplerMS.push_back(
-          *(reinterpret_cast<int32_t*> (&message[54 + (i * 24)])));
-      m_dopplerHz.push_back(
-          *(reinterpret_cast<int32_t*> (&message[58 + (i * 24)])));
-
-      m_wholeChips.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[62 + (i * 24)])));
-      m_fracChips.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[64 + (i * 24)])));
-
-      m_codePhase.push_back(
-          *(reinterpret_cast<uint32_t*> (&message[66 + (i * 24)])));
-
-      m_intCodePhase.push_back(message[70 + (i * 24)]);
-      m_pseuRangeRMSErr.push_back(message[71 + (i * 24)]);
+      m_gnssId[i] = message[50 + (i * 24)];
+      m_svId[i] = message[51 + (i * 24)];
+      m_cNo[i] = message[52 + (i * 24)];
+      m_mpathIndic[i] = message[53 + (i * 24)];
+
+      m_dopplerMS[i] = field<int32_t>(message, 54 + (i * 24));
+      m_dopplerHz[i] = field<int32_t>(message, 58 + (i * 24));
+
+      m_wholeChips[i] = field<uint16_t>(message, 62 + (i * 24));
+      m_fracChips[i] = field<uint16_t>(message, 64 + (i * 24));
+
+      m_codePhase[i] = field<uint32_t>(message, 66 + (i * 24));
+
+      m_intCodePhase[i] = message[70 + (i * 24)];
+      m_pseuRangeRMSErr[i] = message[71 + (i * 24)];
     }
   }
   else
@@ -154,61 +149,116 @@ uint8_t measx::towSet()
   return m_towSet;
 }
 
-std::vector<uint8_t> measx::gnssId()
+const std::vector<uint8_t>& measx::gnssId()
 {
   return m_gnssId;
 }
 
-std::vector<uint8_t> measx::svId()
+uint8_t measx::gnssId(size_t i)
+{
+  return m_gnssId[i];
+}
+
+const std::vector<uint8_t>& measx::svId()
 {
   return m_svId;
 }
 
-std::vector<uint8_t> measx::cNo()
+uint8_t measx::svId(size_t i)
+{
+  return m_svId[i];
+}
+
+const std::vector<uint8_t>& measx::cNo()
 {
   return m_cNo;
 }
 
-std::vector<uint8_t> measx::mpathIndic()
+uint8_t measx::cNo(size_t i)
+{
+  return m_cNo[i];
+}
+
+const std::vector<uint8_t>& measx::mpathIndic()
 {
   return m_mpathIndic;
 }
 
-std::vector<int32_t> measx::dopplerMS()
+uint8_t measx::mpathIndic(size_t i)
+{
+  return m_mpathIndic[i];
+}
+
+const std::vector<int32_t>& measx::dopplerMS()
 {
   return m_dopplerMS;
 }
 
-std::vector<int32_t> measx::dopplerHz()
+int32_t measx::dopplerMS(size_t i)
+{
+  return m_dopplerMS[i];
+}
+
+const std::vector<int32_t>& measx::dopplerHz()
 {
   return m_dopplerHz;
 }
 
-std::vector<uint16_t> measx::wholeChips()
+int32_t measx::dopplerHz(size_t i)
+{
+  return m_dopplerHz[i];
+}
+
+const std::vector<uint16_t>& measx::wholeChips()
 {
   return m_wholeChips;
 }
 
-std::vector<uint16_t> measx::fracChips()
+uint16_t measx::wholeChips(size_t i)
+{
+  return m_wholeChips[i];
+}
+
+const std::vector<uint16_t>& measx::fracChips()
 {
   return m_fracChips;
 }
 
-std::vector<uint32_t> measx::codePhase()
+uint16_t measx::fracChips(size_t i)
+{
+  return m_fracChips[i];
+}
+
+const std::vector<uint32_t>& measx::codePhase()
 {
   return m_codePhase;
 }
 
-std::vector<uint8_t> measx::intCodePhase()
+uint32_t measx::codePhase(size_t i)
+{
+  return m_codePhase[i];
+}
+
+const std::vector<uint8_t>& measx::intCodePhase()
 {
   return m_intCodePhase;
 }
 
-std::vector<uint8_t> measx::pseuRangeRMSErr()
+uint8_t measx::intCodePhase(size_t i)
+{
+  return m_intCodePhase[i];
+}
+
+const std::vector<uint8_t>& measx::pseuRangeRMSErr()
 {
   return m_pseuRangeRMSErr;
 }
 
+uint8_t measx::pseuRangeRMSErr(size_t i)
+{
+  return m_pseuRangeRMSErr[i];
+}
+
 bool measx::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
@@ -226,52 +276,51 @@ void rawx::update(std::vector<uint8_t>& message)
 {
   if (type(message))
   {
-    m_rcvTow = (*(reinterpret_cast<double*> (&message[6])));
+    m_rcvTow = field<double>(message, 6);
 
-    m_week = (*(reinterpret_cast<uint16_t*> (&message[14])));
+    m_week = field<uint16_t>(message, 14);
 
-    m_leapS = (*(reinterpret_cast<int8_t*> (&message[16])));
+    m_leapS = field<int8_t>(message, 16);
 
     m_numMeas = message[17];
-    m_recStat = message[12];
+    m_recStat = message[18];
 
     m_leapSec = m_recStat & 0x01;
-    m_clkReset = m_recStat & 0x02;
-
-    m_prMes.clear();
-    m_cpMes.clear();
-    m_doMes.clear();
-    m_gnssId.clear();
-    m_svId.clear();
-    m_sigId.clear();
-    m_freqId.clear();
-    m_locktime.clear();
-    m_cno.clear();
-    m_prStdev.clear();
-    m_cpStdev.clear();
-    m_doStdev.clear();
-    m_trkStat.clear();
+    m_clkReset = m_recStat >> 1 & 0x01;
+
+    m_prMes.resize(m_numMeas);
+    m_cpMes.resize(m_numMeas);
+    m_doMes.resize(m_numMeas);
+    m_gnssId.resize(m_numMeas);
+    m_svId.resize(m_numMeas);
+    m_sigId.resize(m_numMeas);
+    m_freqId.resize(m_numMeas);
+    m_locktime.resize(m_numMeas);
+    m_cno.resize(m_numMeas);
+    m_prStdev.resize(m_numMeas);
+    m_cpStdev.resize(m_numMeas);
+    m_doStdev.resize(m_numMeas);
+    m_trkStat.resize(m_numMeas);
 
     for (size_t i = 0; i < m_numMeas; ++i)
     {
-      m_prMes.push_back(*(reinterpret_cast<double*> (&message[22 + (i * 32)])));
-      m_cpMes.push_back(*(reinterpret_cast<double*> (&message[30 + (i * 32)])));
+      m_prMes[i] = field<double>(message, 22 + (i * 32));
+      m_cpMes[i] = field<double>(message, 30 + (i * 32));
 
-      m_doMes.push_back(*(reinterpret_cast<float*> (&message[38 + (i * 32)])));
+      m_doMes[i] = field<float>(message, 38 + (i * 32));
 
-      m_gnssId.push_back(message[42 + (i * 32)]);
-      m_svId.push_back(message[43 + (i * 32)]);
-      m_sigId.push_back(message[44 + (i * 32)]);
-      m_freqId.push_back(message[45 + (i * 32)]);
+      m_gnssId[i] = message[42 + (i * 32)];
+      m_svId[i] = message[43 + (i * 32)];
+      m_sigId[i] = message[44 + (i * 32)];
+      m_freqId[i] = message[45 + (i * 32)];
 
-      m_locktime.push_back(
-          *(reinterpret_cast<uint16_t*> (&message[46 + (i * 32)])));
+      m_locktime[i] = field<uint16_t>(message, 46 + (i * 32));
 
-      m_cno.push_back(message[48 + (i * 32)]);
-      m_prStdev.push_back(message[49 + (i * 32)]);
-      m_cpStdev.push_back(message[50 + (i * 32)]);
-      m_doStdev.push_back(message[51 + (i * 32)]);
-      m_trkStat.push_back(message[52 + (i * 32)]);
+      m_cno[i] = message[48 + (i * 32)];
+      m_prStdev[i] = message[49 + (i * 32)] & 0x0f;
+      m_cpStdev[i] = message[50 + (i * 32)] & 0x0f;
+      m_doStdev[i] = message[51 + (i * 32)] & 0x0f;
+      m_trkStat[i] = message[52 + (i * 32)];
     }
   }
   else
@@ -313,71 +362,136 @@ uint8_t rawx::clkReset()
   return m_clkReset;
 }
 
-std::vector<double> rawx::prMes()
+const std::vector<double>& rawx::prMes()
 {
   return m_prMes;
 }
 
-std::vector<double> rawx::cpMes()
+double rawx::prMes(size_t i)
+{
+  return m_prMes[i];
+}
+
+const std::vector<double>& rawx::cpMes()
 {
   return m_cpMes;
 }
 
-std::vector<float> rawx::doMes()
+double rawx::cpMes(size_t i)
+{
+  return m_cpMes[i];
+}
+
+const std::vector<float>& rawx::doMes()
 {
   return m_doMes;
 }
 
-std::vector<uint8_t> rawx::gnssId()
+float rawx::doMes(size_t i)
+{
+  return m_doMes[i];
+}
+
+const std::vector<uint8_t>& rawx::gnssId()
 {
   return m_gnssId;
 }
 
-std::vector<uint8_t> rawx::svId()
+uint8_t rawx::gnssId(size_t i)
+{
+  return m_gnssId[i];
+}
+
+const std::vector<uint8_t>& rawx::svId()
 {
   return m_svId;
 }
 
-std::vector<uint8_t> rawx::sigId()
+uint8_t rawx::svId(size_t i)
+{
+  return m_svId[i];
+}
+
+const std::vector<uint8_t>& rawx::sigId()
 {
   return m_sigId;
 }
 
-std::vector<uint8_t> rawx::freqId()
+uint8_t rawx::sigId(size_t i)
+{
+  return m_sigId[i];
+}
+
+const std::vector<uint8_t>& rawx::freqId()
 {
   return m_freqId;
 }
 
-std::vector<uint16_t> rawx::locktime()
+uint8_t rawx::freqId(size_t i)
+{
+  return m_freqId[i];
+}
+
+const std::vector<uint16_t>& rawx::locktime()
 {
   return m_locktime;
 }
 
-std::vector<uint8_t> rawx::cno()
+uint16_t rawx::locktime(size_t i)
+{
+  return m_locktime[i];
+}
+
+const std::vector<uint8_t>& rawx::cno()
 {
   return m_cno;
 }
 
-std::vector<uint8_t> rawx::prStdev()
+uint8_t rawx::cno(size_t i)
+{
+  return m_cno[i];
+}
+
+const std::vector<uint8_t>& rawx::prStdev()
 {
   return m_prStdev;
 }
 
-std::vector<uint8_t> rawx::cpStdev()
+uint8_t rawx::prStdev(size_t i)
+{
+  return m_prStdev[i];
+}
+
+const std::vector<uint8_t>& rawx::cpStdev()
 {
   return m_cpStdev;
 }
 
-std::vector<uint8_t> rawx::doStdev()
+uint8_t rawx::cpStdev(size_t i)
+{
+  return m_cpStdev[i];
+}
+
+const std::vector<uint8_t>& rawx::doStdev()
 {
   return m_doStdev;
 }
 
-std::vector<uint8_t> rawx::trkStat()
+uint8_t rawx::doStdev(size_t i)
+{
+  return m_doStdev[i];
+}
+
+const std::vector<uint8_t>& rawx::trkStat()
 {
   return m_trkStat;
 }
 
+uint8_t rawx::trkStat(size_t i)
+{
+  return m_trkStat[i];
+}
+
 bool rawx::type(std::vector<uint8_t>& message)
 {
   return (!message.empty()
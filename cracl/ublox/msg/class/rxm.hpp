@@ -21,6 +21,8 @@
 #ifndef CRACL_UBLOX_MSG_CLASS_RXM_HPP
 #define CRACL_UBLOX_MSG_CLASS_RXM_HPP
 
+#include "../base.hpp"
+
 #include <cstdint>
 #include <vector>
 
@@ -95,32 +97,124 @@ public:
 
   uint8_t towSet();
 
-  std::vector<uint8_t> gnssId();
+  const std::vector<uint8_t>& gnssId();
+
+  uint8_t gnssId(size_t i);
+
+  const std::vector<uint8_t>& svId();
+
+  uint8_t svId(size_t i);
+
+  const std::vector<uint8_t>& cNo();
+
+  uint8_t cNo(size_t i);
+
+  const std::vector<uint8_t>& mpathIndic();
+
+  uint8_t mpathIndic(size_t i);
+
+  const std::vector<int32_t>& dopplerMS();
+
+  int32_t dopplerMS(size_t i);
 
-  std::vector<uint8_t> svId();
+  const std::vector<int32_t>& dopplerHz();
 
-  std::vector<uint8_t> cNo();
+  int32_t dopplerHz(size_t i);
 
-  std::vector<uint8_t> mpathIndic();
+  const std::vector<uint16_t>& wholeChips();
 
-  std::vector<int32_t> dopplerMS();
+  uint16_t wholeChips(size_t i);
 
-  std::vector<int32_t> dopplerHz();
+  const std::vector<uint16_t>& fracChips();
 
-  std::vector<uint16_t> wholeChips();
+  uint16_t fracChips(size_t i);
 
-  std::vector<uint16_t> fracChips();
+  const std::vector<uint32_t>& codePhase();
 
-  std::vector<uint32_t> codePhase();
+  uint32_t codePhase(size_t i);
 
-  std::vector<uint8_t> intCodePhase();
+  const std::vector<uint8_t>& intCodePhase();
 
-  std::vector<uint8_t> pseuRangeRMSErr();
+  uint8_t intCodePhase(size_t i);
+
+  const std::vector<uint8_t>& pseuRangeRMSErr();
+
+  uint8_t pseuRangeRMSErr(size_t i);
+
+  static const char* msg_class() { return "RXM"; }
+
+  static const char* msg_id() { return "MEASX"; }
 
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::rxm::measx
 
+class measx_view : public view
+{
+public:
+  using view::view;
+
+  uint8_t version() const { return m_data[6]; }
+
+  uint32_t gpsTOW() const { return field<uint32_t>(m_data + 10); }
+
+  uint32_t gloTOW() const { return field<uint32_t>(m_data + 14); }
+
+  uint32_t bdsTOW() const { return field<uint32_t>(m_data + 18); }
+
+  uint32_t qzssTOW() const { return field<uint32_t>(m_data + 26); }
+
+  uint16_t gpsTOWacc() const { return field<uint16_t>(m_data + 30); }
+
+  uint16_t gloTOWacc() const { return field<uint16_t>(m_data + 32); }
+
+  uint16_t bdsTOWacc() const { return field<uint16_t>(m_data + 34); }
+
+  uint16_t qzssTOWacc() const { return field<uint16_t>(m_data + 38); }
+
+  uint8_t numSV() const { return m_data[40]; }
+
+  uint8_t towSet() const { return m_data[41] & 0x03; }
+
+  uint8_t gnssId(size_t i) const { return m_data[50 + (i * 24)]; }
+
+  uint8_t svId(size_t i) const { return m_data[51 + (i * 24)]; }
+
+  uint8_t cNo(size_t i) const { return m_data[52 + (i * 24)]; }
+
+  uint8_t mpathIndic(size_t i) const { return m_data[53 + (i * 24)]; }
+
+  int32_t dopplerMS(size_t i) const
+  {
+    return field<int32_t>(m_data + 54 + (i * 24));
+  }
+
+  int32_t dopplerHz(size_t i) const
+  {
+    return field<int32_t>(m_data + 58 + (i * 24));
+  }
+
+  uint16_t wholeChips(size_t i) const
+  {
+    return field<uint16_t>(m_data + 62 + (i * 24));
+  }
+
+  uint16_t fracChips(size_t i) const
+  {
+    return field<uint16_t>(m_data + 64 + (i * 24));
+  }
+
+  uint32_t codePhase(size_t i) const
+  {
+    return field<uint32_t>(m_data + 66 + (i * 24));
+  }
+
+  uint8_t intCodePhase(size_t i) const { return m_data[70 + (i * 24)]; }
+
+  uint8_t pseuRangeRMSErr(size_t i) const { return m_data[71 + (i * 24)]; }
+
+}; // ubx::rxm::measx_view
+
 class rawx
 {
   double m_rcvTow;
@@ -173,36 +267,116 @@ public:
 
   uint8_t clkReset();
 
-  std::vector<double> prMes();
+  const std::vector<double>& prMes();
 
-  std::vector<double> cpMes();
+  double prMes(size_t i);
 
-  std::vector<float> doMes();
+  const std::vector<double>& cpMes();
 
-  std::vector<uint8_t> gnssId();
+  double cpMes(size_t i);
 
-  std::vector<uint8_t> svId();
+  const std::vector<float>& doMes();
 
-  std::vector<uint8_t> sigId();
+  float doMes(size_t i);
 
-  std::vector<uint8_t> freqId();
+  const std::vector<uint8_t>& gnssId();
 
-  std::vector<uint16_t> locktime();
+  uint8_t gnssId(size_t i);
 
-  std::vector<uint8_t> cno();
+  const std::vector<uint8_t>& svId();
 
-  std::vector<uint8_t> prStdev();
+  uint8_t svId(size_t i);
 
-  std::vector<uint8_t> cpStdev();
+  const std::vector<uint8_t>& sigId();
 
-  std::vector<uint8_t> doStdev();
+  uint8_t sigId(size_t i);
 
-  std::vector<uint8_t> trkStat();
+  const std::vector<uint8_t>& freqId();
+
+  uint8_t freqId(size_t i);
+
+  const std::vector<uint16_t>& locktime();
+
+  uint16_t locktime(size_t i);
+
+  const std::vector<uint8_t>& cno();
+
+  uint8_t cno(size_t i);
+
+  const std::vector<uint8_t>& prStdev();
+
+  uint8_t prStdev(size_t i);
+
+  const std::vector<uint8_t>& cpStdev();
+
+  uint8_t cpStdev(size_t i);
+
+  const std::vector<uint8_t>& doStdev();
+
+  uint8_t doStdev(size_t i);
+
+  const std::vector<uint8_t>& trkStat();
+
+  uint8_t trkStat(size_t i);
+
+  static const char* msg_class() { return "RXM"; }
+
+  static const char* msg_id() { return "RAWX"; }
 
   static bool type(std::vector<uint8_t>& message);
 
 }; // ubx::rxm::rawx
 
+class rawx_view : public view
+{
+public:
+  using view::view;
+
+  double rcvTow() const { return field<double>(m_data + 6); }
+
+  uint16_t week() const { return field<uint16_t>(m_data + 14); }
+
+  int8_t leapS() const { return field<int8_t>(m_data + 16); }
+
+  uint8_t numMeas() const { return m_data[17]; }
+
+  uint8_t recStat() const { return m_data[18]; }
+
+  uint8_t leapSec() const { return m_data[18] & 0x01; }
+
+  uint8_t clkReset() const { return m_data[18] >> 1 & 0x01; }
+
+  double prMes(size_t i) const { return field<double>(m_data + 22 + (i * 32)); }
+
+  double cpMes(size_t i) const { return field<double>(m_data + 30 + (i * 32)); }
+
+  float doMes(size_t i) const { return field<float>(m_data + 38 + (i * 32)); }
+
+  uint8_t gnssId(size_t i) const { return m_data[42 + (i * 32)]; }
+
+  uint8_t svId(size_t i) const { return m_data[43 + (i * 32)]; }
+
+  uint8_t sigId(size_t i) const { return m_data[44 + (i * 32)]; }
+
+  uint8_t freqId(size_t i) const { return m_data[45 + (i * 32)]; }
+
+  uint16_t locktime(size_t i) const
+  {
+    return field<uint16_t>(m_data + 46 + (i * 32));
+  }
+
+  uint8_t cno(size_t i) const { return m_data[48 + (i * 32)]; }
+
+  uint8_t prStdev(size_t i) const { return m_data[49 + (i * 32)] & 0x0f; }
+
+  uint8_t cpStdev(size_t i) const { return m_data[50 + (i * 32)] & 0x0f; }
+
+  uint8_t doStdev(size_t i) const { return m_data[51 + (i * 32)] & 0x0f; }
+
+  uint8_t trkStat(size_t i) const { return m_data[52 + (i * 32)]; }
+
+}; // ubx::rxm::rawx_view
+
 } // namespace rxm
 
 } // namespace ubx
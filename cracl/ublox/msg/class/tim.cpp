@@ -0,0 +1,249 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "tim.hpp"
+
+#include "../base.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace tim
+{
+
+tm2::tm2(std::vector<uint8_t>& message)
+{
+  update(message);
+}
+
+void tm2::update(std::vector<uint8_t>& message)
+{
+  if (type(message))
+  {
+    m_ch = message[6];
+
+    m_mode = message[7] & 0x01;
+    m_run = message[7] >> 1 & 0x01;
+    m_newFallingEdge = message[7] >> 2 & 0x01;
+    m_timeBase = message[7] >> 3 & 0x03;
+    m_utc = message[7] >> 5 & 0x01;
+    m_time = message[7] >> 6 & 0x01;
+    m_newRisingEdge = message[7] >> 7 & 0x01;
+
+    m_count = field<uint16_t>(message, 8);
+    m_wnR = field<uint16_t>(message, 10);
+    m_wnF = field<uint16_t>(message, 12);
+
+    m_towMsR = field<uint32_t>(message, 14);
+    m_towSubMsR = field<uint32_t>(message, 18);
+    m_towMsF = field<uint32_t>(message, 22);
+    m_towSubMsF = field<uint32_t>(message, 26);
+    m_accEst = field<uint32_t>(message, 30);
+  }
+  else
+    throw std::runtime_error("Message type mismatch");
+}
+
+uint8_t tm2::ch()
+{
+  return m_ch;
+}
+
+uint8_t tm2::mode()
+{
+  return m_mode;
+}
+
+uint8_t tm2::run()
+{
+  return m_run;
+}
+
+uint8_t tm2::newFallingEdge()
+{
+  return m_newFallingEdge;
+}
+
+uint8_t tm2::timeBase()
+{
+  return m_timeBase;
+}
+
+uint8_t tm2::utc()
+{
+  return m_utc;
+}
+
+uint8_t tm2::time()
+{
+  return m_time;
+}
+
+uint8_t tm2::newRisingEdge()
+{
+  return m_newRisingEdge;
+}
+
+uint16_t tm2::count()
+{
+  return m_count;
+}
+
+uint16_t tm2::wnR()
+{
+  return m_wnR;
+}
+
+uint16_t tm2::wnF()
+{
+  return m_wnF;
+}
+
+uint32_t tm2::towMsR()
+{
+  return m_towMsR;
+}
+
+uint32_t tm2::towSubMsR()
+{
+  return m_towSubMsR;
+}
+
+uint32_t tm2::towMsF()
+{
+  return m_towMsF;
+}
+
+uint32_t tm2::towSubMsF()
+{
+  return m_towSubMsF;
+}
+
+uint32_t tm2::accEst()
+{
+  return m_accEst;
+}
+
+bool tm2::type(std::vector<uint8_t>& message)
+{
+  return (!message.empty()
+      && valid_checksum(message)
+      && message[2] == ubx::msg_map.at("TIM").first
+      && message[3] == ubx::msg_map.at("TIM").second.at("TM2"));
+}
+
+tp::tp(std::vector<uint8_t>& message)
+{
+  update(message);
+}
+
+void tp::update(std::vector<uint8_t>& message)
+{
+  if (type(message))
+  {
+    m_towMS = field<uint32_t>(message, 6);
+    m_towSubMS = field<uint32_t>(message, 10);
+
+    m_qErr = field<int32_t>(message, 14);
+
+    m_week = field<uint16_t>(message, 18);
+
+    m_timeBase = message[20] & 0x01;
+    m_utc = message[20] >> 1 & 0x01;
+    m_raim = message[20] >> 2 & 0x03;
+    m_qErrInvalid = message[20] >> 4 & 0x01;
+
+    m_timeRefGnss = message[21] & 0x0f;
+    m_utcStandard = message[21] >> 4 & 0x0f;
+  }
+  else
+    throw std::runtime_error("Message type mismatch");
+}
+
+uint32_t tp::towMS()
+{
+  return m_towMS;
+}
+
+uint32_t tp::towSubMS()
+{
+  return m_towSubMS;
+}
+
+int32_t tp::qErr()
+{
+  return m_qErr;
+}
+
+uint16_t tp::week()
+{
+  return m_week;
+}
+
+uint8_t tp::timeBase()
+{
+  return m_timeBase;
+}
+
+uint8_t tp::utc()
+{
+  return m_utc;
+}
+
+uint8_t tp::raim()
+{
+  return m_raim;
+}
+
+uint8_t tp::qErrInvalid()
+{
+  return m_qErrInvalid;
+}
+
+uint8_t tp::timeRefGnss()
+{
+  return m_timeRefGnss;
+}
+
+uint8_t tp::utcStandard()
+{
+  return m_utcStandard;
+}
+
+bool tp::type(std::vector<uint8_t>& message)
+{
+  return (!message.empty()
+      && valid_checksum(message)
+      && message[2] == ubx::msg_map.at("TIM").first
+      && message[3] == ubx::msg_map.at("TIM").second.at("TP"));
+}
+
+} // namespace tim
+
+} // namespace ubx
+
+} // namespace cracl
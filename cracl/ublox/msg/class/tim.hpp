@@ -0,0 +1,231 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_MSG_CLASS_TIM_HPP
+#define CRACL_UBLOX_MSG_CLASS_TIM_HPP
+
+#include "../base.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace tim
+{
+
+class tm2
+{
+  uint8_t m_ch;
+
+  uint8_t m_mode;
+  uint8_t m_run;
+  uint8_t m_newFallingEdge;
+  uint8_t m_timeBase;
+  uint8_t m_utc;
+  uint8_t m_time;
+  uint8_t m_newRisingEdge;
+
+  uint16_t m_count;
+  uint16_t m_wnR;
+  uint16_t m_wnF;
+
+  uint32_t m_towMsR;
+  uint32_t m_towSubMsR;
+  uint32_t m_towMsF;
+  uint32_t m_towSubMsF;
+  uint32_t m_accEst;
+
+public:
+  tm2(){ }
+
+  tm2(std::vector<uint8_t>& message);
+
+  void update(std::vector<uint8_t>& message);
+
+  uint8_t ch();
+
+  uint8_t mode();
+
+  uint8_t run();
+
+  uint8_t newFallingEdge();
+
+  uint8_t timeBase();
+
+  uint8_t utc();
+
+  uint8_t time();
+
+  uint8_t newRisingEdge();
+
+  uint16_t count();
+
+  uint16_t wnR();
+
+  uint16_t wnF();
+
+  uint32_t towMsR();
+
+  uint32_t towSubMsR();
+
+  uint32_t towMsF();
+
+  uint32_t towSubMsF();
+
+  uint32_t accEst();
+
+  static const char* msg_class() { return "TIM"; }
+
+  static const char* msg_id() { return "TM2"; }
+
+  static bool type(std::vector<uint8_t>& message);
+
+}; // ubx::tim::tm2
+
+class tm2_view : public view
+{
+public:
+  using view::view;
+
+  uint8_t ch() const { return m_data[6]; }
+
+  uint8_t mode() const { return m_data[7] & 0x01; }
+
+  uint8_t run() const { return m_data[7] >> 1 & 0x01; }
+
+  uint8_t newFallingEdge() const { return m_data[7] >> 2 & 0x01; }
+
+  uint8_t timeBase() const { return m_data[7] >> 3 & 0x03; }
+
+  uint8_t utc() const { return m_data[7] >> 5 & 0x01; }
+
+  uint8_t time() const { return m_data[7] >> 6 & 0x01; }
+
+  uint8_t newRisingEdge() const { return m_data[7] >> 7 & 0x01; }
+
+  uint16_t count() const { return field<uint16_t>(m_data + 8); }
+
+  uint16_t wnR() const { return field<uint16_t>(m_data + 10); }
+
+  uint16_t wnF() const { return field<uint16_t>(m_data + 12); }
+
+  uint32_t towMsR() const { return field<uint32_t>(m_data + 14); }
+
+  uint32_t towSubMsR() const { return field<uint32_t>(m_data + 18); }
+
+  uint32_t towMsF() const { return field<uint32_t>(m_data + 22); }
+
+  uint32_t towSubMsF() const { return field<uint32_t>(m_data + 26); }
+
+  uint32_t accEst() const { return field<uint32_t>(m_data + 30); }
+
+}; // ubx::tim::tm2_view
+
+class tp
+{
+  uint32_t m_towMS;
+  uint32_t m_towSubMS;
+
+  int32_t m_qErr;
+
+  uint16_t m_week;
+
+  uint8_t m_timeBase;
+  uint8_t m_utc;
+  uint8_t m_raim;
+  uint8_t m_qErrInvalid;
+
+  uint8_t m_timeRefGnss;
+  uint8_t m_utcStandard;
+
+public:
+  tp(){ }
+
+  tp(std::vector<uint8_t>& message);
+
+  void update(std::vector<uint8_t>& message);
+
+  uint32_t towMS();
+
+  uint32_t towSubMS();
+
+  int32_t qErr();
+
+  uint16_t week();
+
+  uint8_t timeBase();
+
+  uint8_t utc();
+
+  uint8_t raim();
+
+  uint8_t qErrInvalid();
+
+  uint8_t timeRefGnss();
+
+  uint8_t utcStandard();
+
+  static const char* msg_class() { return "TIM"; }
+
+  static const char* msg_id() { return "TP"; }
+
+  static bool type(std::vector<uint8_t>& message);
+
+}; // ubx::tim::tp
+
+class tp_view : public view
+{
+public:
+  using view::view;
+
+  uint32_t towMS() const { return field<uint32_t>(m_data + 6); }
+
+  uint32_t towSubMS() const { return field<uint32_t>(m_data + 10); }
+
+  int32_t qErr() const { return field<int32_t>(m_data + 14); }
+
+  uint16_t week() const { return field<uint16_t>(m_data + 18); }
+
+  uint8_t timeBase() const { return m_data[20] & 0x01; }
+
+  uint8_t utc() const { return m_data[20] >> 1 & 0x01; }
+
+  uint8_t raim() const { return m_data[20] >> 2 & 0x03; }
+
+  uint8_t qErrInvalid() const { return m_data[20] >> 4 & 0x01; }
+
+  uint8_t timeRefGnss() const { return m_data[21] & 0x0f; }
+
+  uint8_t utcStandard() const { return m_data[21] >> 4 & 0x0f; }
+
+}; // ubx::tim::tp_view
+
+} // namespace tim
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_MSG_CLASS_TIM_HPP
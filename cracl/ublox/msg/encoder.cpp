@@ -0,0 +1,90 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "encoder.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+encoder::encoder(uint8_t* data, size_t capacity)
+  : m_data(data), m_capacity(capacity), m_size(0), m_frame_end(0),
+    m_check_a(0), m_check_b(0)
+{ }
+
+void encoder::begin(uint8_t msg_class, uint8_t msg_id, uint16_t length)
+{
+  if (m_size + 8 + length > m_capacity)
+    throw std::runtime_error("UBX encoder buffer too small");
+
+  m_data[m_size++] = 0xb5; // μ
+  m_data[m_size++] = 0x62; // b
+
+  // Checksum covers class, ID, length and payload
+  m_check_a = 0;
+  m_check_b = 0;
+
+  m_frame_end = m_size + 4 + length;
+
+  put_byte(msg_class);
+  put_byte(msg_id);
+  put(length);
+}
+
+void encoder::end()
+{
+  if (m_size != m_frame_end)
+    throw std::runtime_error("UBX payload shorter than declared length");
+
+  m_data[m_size++] = m_check_a;
+  m_data[m_size++] = m_check_b;
+
+  m_frame_end = m_size;
+}
+
+const uint8_t* encoder::data() const
+{
+  return m_data;
+}
+
+size_t encoder::size() const
+{
+  return m_size;
+}
+
+size_t encoder::capacity() const
+{
+  return m_capacity;
+}
+
+void encoder::clear()
+{
+  m_size = 0;
+  m_frame_end = 0;
+}
+
+} // namespace ubx
+
+} // namespace cracl
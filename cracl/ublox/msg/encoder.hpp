@@ -0,0 +1,181 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_MSG_ENCODER_HPP
+#define CRACL_UBLOX_MSG_ENCODER_HPP
+
+#include "base.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Number of payload bytes occupied by a list of UBX field types
+ */
+template <typename... Args>
+struct payload_size;
+
+template <>
+struct payload_size<>
+{
+  static constexpr size_t value = 0;
+};
+
+template <typename T, typename... Args>
+struct payload_size<T, Args...>
+{
+  static constexpr size_t value = sizeof (T) + payload_size<Args...>::value;
+};
+
+/* @brief Number of bytes in a complete UBX frame (header, length, payload and
+ *        checksum) carrying the given field types
+ */
+template <typename... Args>
+struct frame_size
+{
+  static constexpr size_t value = 8 + payload_size<Args...>::value;
+};
+
+/* @brief Serializes UBX frames into a caller provided buffer
+ *
+ * Fields are written little endian and the 8-bit Fletcher checksum is updated
+ * as each byte is written, so a frame is complete as soon as its last field
+ * is. Several frames may be appended back to back so that a batch of commands
+ * can be handed to the port in a single write.
+ */
+class encoder
+{
+  uint8_t* m_data;
+
+  size_t m_capacity;
+  size_t m_size;
+  size_t m_frame_end;
+
+  uint8_t m_check_a;
+  uint8_t m_check_b;
+
+  void put_byte(uint8_t byte)
+  {
+    m_data[m_size++] = byte;
+
+    m_check_b += (m_check_a += byte);
+  }
+
+  void put_fields() { }
+
+  template <typename T, typename... Args>
+  void put_fields(T t, Args... args)
+  {
+    put(t);
+
+    put_fields(args...);
+  }
+
+public:
+  encoder(uint8_t* data, size_t capacity);
+
+  encoder(const encoder&) = delete;
+
+  encoder& operator=(const encoder&) = delete;
+
+  /* @brief Start a frame with a payload of length bytes, which must then be
+   *        written with put() before calling end()
+   */
+  void begin(uint8_t msg_class, uint8_t msg_id, uint16_t length);
+
+  template <typename T>
+  void put(T t)
+  {
+    static_assert(std::is_arithmetic<T>::value,
+        "UBX fields must be arithmetic types");
+
+    if (m_size + sizeof (T) > m_frame_end)
+      throw std::runtime_error("UBX payload exceeds declared length");
+
+    typename detail::raw<sizeof (T)>::type x;
+
+    std::memcpy(&x, &t, sizeof (T));
+
+    // Shifting the integer representation yields little endian byte order
+    //   regardless of host endianness
+    for (size_t i = 0; i < sizeof (T); ++i)
+      put_byte(static_cast<uint8_t>(x >> (8 * i)));
+  }
+
+  /* @brief Append the checksum, completing the current frame
+   */
+  void end();
+
+  /* @brief Encode a complete frame whose payload is the given fields, in order
+   */
+  template <typename... Args>
+  void add(uint8_t msg_class, uint8_t msg_id, Args... args)
+  {
+    begin(msg_class, msg_id, payload_size<Args...>::value);
+
+    put_fields(args...);
+
+    end();
+  }
+
+  const uint8_t* data() const;
+
+  size_t size() const;
+
+  size_t capacity() const;
+
+  void clear();
+
+}; // ubx::encoder
+
+namespace detail
+{
+
+// Buffer held as a base so that it is constructed before the encoder using it
+template <size_t N>
+struct storage
+{
+  std::array<uint8_t, N> m_buffer;
+};
+
+} // namespace detail
+
+/* @brief Encoder which owns a fixed size buffer, for example on the stack
+ */
+template <size_t N>
+class static_encoder : private detail::storage<N>, public encoder
+{
+public:
+  static_encoder() : encoder(this->m_buffer.data(), N) { }
+
+}; // ubx::static_encoder
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_MSG_ENCODER_HPP
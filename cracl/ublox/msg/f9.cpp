@@ -20,6 +20,7 @@
 
 #include "f9.hpp"
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -198,6 +199,25 @@ extern const std::map<std::string,
         }
       }
     },
+    { "NMEA",
+      { 0xF0,
+        {
+          { "DTM", 0x0a },
+          { "GBS", 0x09 },
+          { "GGA", 0x00 },
+          { "GLL", 0x01 },
+          { "GNS", 0x0d },
+          { "GRS", 0x06 },
+          { "GSA", 0x02 },
+          { "GST", 0x07 },
+          { "GSV", 0x03 },
+          { "RMC", 0x04 },
+          { "VLW", 0x0f },
+          { "VTG", 0x05 },
+          { "ZDA", 0x08 }
+        }
+      }
+    },
     { "PUBX",
       { 0xF1,
         {
@@ -211,6 +231,85 @@ extern const std::map<std::string,
     }
   };
 
+extern const std::map<std::string, std::map<std::string, uint32_t>>
+  f9_msgout_map = {
+    { "MON",
+      {
+        { "COMMS", 0x2091034f },
+        { "HW2", 0x209101b9 },
+        { "HW3", 0x20910354 },
+        { "HW", 0x209101b4 },
+        { "IO", 0x209101a5 },
+        { "MSGPP", 0x20910196 },
+        { "RF", 0x20910359 },
+        { "RXBUF", 0x209101a0 },
+        { "RXR", 0x20910187 },
+        { "TXBUF", 0x2091019b }
+      }
+    },
+    { "NAV",
+      {
+        { "CLOCK", 0x20910065 },
+        { "DOP", 0x20910038 },
+        { "EOE", 0x2091015f },
+        { "GEOFENCE", 0x209100a1 },
+        { "HPPOSECEF", 0x2091002e },
+        { "HPPOSLLH", 0x20910033 },
+        { "ODO", 0x2091007e },
+        { "ORB", 0x20910010 },
+        { "POSECEF", 0x20910024 },
+        { "POSLLH", 0x20910029 },
+        { "PVT", 0x20910006 },
+        { "RELPOSNED", 0x2091008d },
+        { "SAT", 0x20910015 },
+        { "SIG", 0x20910345 },
+        { "STATUS", 0x2091001a },
+        { "SVIN", 0x20910088 },
+        { "TIMEBDS", 0x20910051 },
+        { "TIMEGAL", 0x20910056 },
+        { "TIMEGLO", 0x2091004c },
+        { "TIMEGPS", 0x20910047 },
+        { "TIMELS", 0x20910060 },
+        { "TIMEUTC", 0x2091005b },
+        { "VELECEF", 0x2091003d },
+        { "VELNED", 0x20910042 }
+      }
+    },
+    { "NMEA",
+      {
+        { "DTM", 0x209100a6 },
+        { "GBS", 0x209100dd },
+        { "GGA", 0x209100ba },
+        { "GLL", 0x209100c9 },
+        { "GNS", 0x209100b5 },
+        { "GRS", 0x209100ce },
+        { "GSA", 0x209100bf },
+        { "GST", 0x209100d3 },
+        { "GSV", 0x209100c4 },
+        { "RMC", 0x209100ab },
+        { "VLW", 0x209100e7 },
+        { "VTG", 0x209100b0 },
+        { "ZDA", 0x209100d8 }
+      }
+    },
+    { "RXM",
+      {
+        { "MEASX", 0x20910204 },
+        { "RAWX", 0x209102a4 },
+        { "RLM", 0x2091025e },
+        { "RTCM", 0x20910268 },
+        { "SFRBX", 0x20910231 }
+      }
+    },
+    { "TIM",
+      {
+        { "TM2", 0x20910178 },
+        { "TP", 0x2091017d },
+        { "VRFY", 0x20910092 }
+      }
+    }
+  };
+
 } // namespace ubx
 
 } // namespace cracl
@@ -26,6 +26,7 @@
 #include "class/mon.hpp"
 #include "class/nav.hpp"
 #include "class/rxm.hpp"
+#include "class/tim.hpp"
 
 namespace cracl
 {
@@ -37,6 +38,13 @@ extern const std::map<std::string,
        std::pair<uint8_t, std::map<std::string, uint8_t>>>
   f9_map;
 
+/* @brief CFG-MSGOUT configuration key IDs controlling the output rate of each
+ *        message on the I2C port. Keys for the other ports follow in order
+ *        (UART1, UART2, USB, SPI), i.e. add the ubx::port_id to the key ID
+ */
+extern const std::map<std::string, std::map<std::string, uint32_t>>
+  f9_msgout_map;
+
 }
 
 }
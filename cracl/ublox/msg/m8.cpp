@@ -247,6 +247,25 @@ extern const std::map<std::string,
         }
       }
     },
+    { "NMEA",
+      { 0xF0,
+        {
+          { "DTM", 0x0a },
+          { "GBS", 0x09 },
+          { "GGA", 0x00 },
+          { "GLL", 0x01 },
+          { "GNS", 0x0d },
+          { "GRS", 0x06 },
+          { "GSA", 0x02 },
+          { "GST", 0x07 },
+          { "GSV", 0x03 },
+          { "RMC", 0x04 },
+          { "VLW", 0x0f },
+          { "VTG", 0x05 },
+          { "ZDA", 0x08 }
+        }
+      }
+    },
     { "PUBX",
       { 0xF1,
         {
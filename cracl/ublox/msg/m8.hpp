@@ -26,6 +26,7 @@
 #include "class/mon.hpp"
 #include "class/nav.hpp"
 #include "class/rxm.hpp"
+#include "class/tim.hpp"
 
 namespace cracl
 {
@@ -0,0 +1,281 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "planner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+// UBX framing adds 8 bytes (header, class, ID, length, checksum). NMEA and
+//   PUBX sentences are at most 82 bytes, except PUBX,03 which has a fixed part
+//   and a block per satellite. GSV carries 4 satellites per sentence, and
+//   sentences repeated per constellation (including a partly filled GSV
+//   sentence) assume up to 6 constellations
+const std::map<std::string, std::map<std::string, layout>> layout_map = {
+  { "MON",
+    {
+      { "COMMS",     {  16, 40, layout::none,       5 } },
+      { "HW",        {  68,  0, layout::none,       0 } },
+      { "HW2",       {  36,  0, layout::none,       0 } },
+      { "IO",        {   8, 20, layout::none,       6 } },
+      { "RF",        {  12, 24, layout::none,       2 } },
+      { "SPAN",      {  12, 272, layout::none,      2 } },
+      { "TXBUF",     {  36,  0, layout::none,       0 } }
+    }
+  },
+  { "NAV",
+    {
+      { "CLOCK",     {  28,  0, layout::none,       0 } },
+      { "DOP",       {  26,  0, layout::none,       0 } },
+      { "EOE",       {  12,  0, layout::none,       0 } },
+      { "HPPOSECEF", {  36,  0, layout::none,       0 } },
+      { "HPPOSLLH",  {  44,  0, layout::none,       0 } },
+      { "ORB",       {  16,  6, layout::satellites, 0 } },
+      { "POSECEF",   {  28,  0, layout::none,       0 } },
+      { "POSLLH",    {  36,  0, layout::none,       0 } },
+      { "PVT",       { 100,  0, layout::none,       0 } },
+      { "RELPOSNED", {  72,  0, layout::none,       0 } },
+      { "SAT",       {  16, 12, layout::satellites, 0 } },
+      { "SIG",       {  16, 16, layout::signals,    0 } },
+      { "STATUS",    {  24,  0, layout::none,       0 } },
+      { "SVIN",      {  48,  0, layout::none,       0 } },
+      { "SVINFO",    {  16, 12, layout::satellites, 0 } },
+      { "TIMEBDS",   {  28,  0, layout::none,       0 } },
+      { "TIMEGAL",   {  28,  0, layout::none,       0 } },
+      { "TIMEGLO",   {  28,  0, layout::none,       0 } },
+      { "TIMEGPS",   {  24,  0, layout::none,       0 } },
+      { "TIMELS",    {  32,  0, layout::none,       0 } },
+      { "TIMEUTC",   {  28,  0, layout::none,       0 } },
+      { "VELECEF",   {  28,  0, layout::none,       0 } },
+      { "VELNED",    {  44,  0, layout::none,       0 } }
+    }
+  },
+  { "NMEA",
+    {
+      { "DTM",       {   0, 82, layout::none,       1 } },
+      { "GBS",       {   0, 82, layout::none,       1 } },
+      { "GGA",       {   0, 82, layout::none,       1 } },
+      { "GLL",       {   0, 82, layout::none,       1 } },
+      { "GNS",       {   0, 82, layout::none,       1 } },
+      { "GRS",       {   0, 82, layout::none,       6 } },
+      { "GSA",       {   0, 82, layout::none,       6 } },
+      { "GST",       {   0, 82, layout::none,       1 } },
+      { "GSV",       {   0, 82, layout::sentences,  6 } },
+      { "RMC",       {   0, 82, layout::none,       1 } },
+      { "VLW",       {   0, 82, layout::none,       1 } },
+      { "VTG",       {   0, 82, layout::none,       1 } },
+      { "ZDA",       {   0, 82, layout::none,       1 } }
+    }
+  },
+  { "PUBX",
+    {
+      { "POSITION",  {   0, 82, layout::none,       2 } },
+      { "SVSTATUS",  {  20, 28, layout::satellites, 0 } },
+      { "TIME",      {   0, 82, layout::none,       1 } }
+    }
+  },
+  { "RXM",
+    {
+      { "MEASX",     {  52, 24, layout::satellites, 0 } },
+      { "RAWX",      {  24, 32, layout::signals,    0 } },
+      { "RTCM",      {  16,  0, layout::none,       0 } },
+      { "SFRBX",     {   0, 56, layout::subframes,  0 } }
+    }
+  },
+  { "TIM",
+    {
+      { "SVIN",      {  36,  0, layout::none,       0 } },
+      { "TM2",       {  36,  0, layout::none,       0 } },
+      { "TP",        {  24,  0, layout::none,       0 } },
+      { "VRFY",      {  28,  0, layout::none,       0 } }
+    }
+  }
+};
+
+planner::planner(double nav_rate, size_t satellites, size_t signals)
+  : m_nav_rate(nav_rate), m_satellites(satellites), m_signals(signals)
+{ }
+
+size_t planner::frame_size(const std::string& msg_class,
+    const std::string& msg_id) const
+{
+  auto cls = layout_map.find(msg_class);
+
+  if (cls == layout_map.end()
+      || cls->second.find(msg_id) == cls->second.end())
+    throw std::runtime_error("No layout for message: " + msg_class + "-"
+        + msg_id);
+
+  const layout& msg = cls->second.at(msg_id);
+
+  size_t blocks = msg.extra;
+
+  switch (msg.count)
+  {
+    case layout::satellites: blocks += m_satellites; break;
+    case layout::signals: blocks += m_signals; break;
+    case layout::sentences: blocks += (m_satellites + 3) / 4; break;
+    case layout::subframes: blocks += m_signals; break;
+    case layout::none: break;
+  }
+
+  return msg.fixed + msg.block * blocks;
+}
+
+double planner::bytes_per_second(const std::string& msg_class,
+    const std::string& msg_id, uint8_t rate) const
+{
+  if (rate == 0)
+    return 0;
+
+  // Subframes (at most one per signal per second) are output as they are
+  //   decoded, independent of the navigation rate
+  if (layout_map.at(msg_class).at(msg_id).count == layout::subframes)
+    return frame_size(msg_class, msg_id);
+
+  return frame_size(msg_class, msg_id) * m_nav_rate / rate;
+}
+
+double planner::bytes_per_second(const rate_profile& profile) const
+{
+  double total = 0;
+
+  for (const auto& msg_class : profile)
+    for (const auto& msg_id : msg_class.second)
+      total += bytes_per_second(msg_class.first, msg_id.first,
+          msg_id.second);
+
+  return total;
+}
+
+double planner::capacity(size_t baud_rate)
+{
+  return baud_rate / 10.0;
+}
+
+double planner::utilization(const rate_profile& profile,
+    size_t baud_rate) const
+{
+  return bytes_per_second(profile) / capacity(baud_rate);
+}
+
+size_t planner::baud_rate(const rate_profile& profile,
+    double max_utilization, size_t max_baud_rate) const
+{
+  static const std::array<size_t, 8> rates = { 9600, 19200, 38400, 57600,
+    115200, 230400, 460800, 921600 };
+
+  const double required = bytes_per_second(profile);
+
+  for (size_t rate : rates)
+    if (rate <= max_baud_rate && required <= capacity(rate) * max_utilization)
+      return rate;
+
+  return 0;
+}
+
+rate_profile planner::fit(const rate_profile& profile, size_t baud_rate,
+    double max_utilization) const
+{
+  rate_profile fitted = profile;
+
+  const double available = capacity(baud_rate) * max_utilization;
+
+  double total = bytes_per_second(fitted);
+
+  while (total > available)
+  {
+    uint8_t* largest = nullptr;
+    double largest_rate = 0;
+
+    // Find the biggest contributor whose rate can still be lowered
+    for (auto& msg_class : fitted)
+      for (auto& msg_id : msg_class.second)
+      {
+        if (msg_id.second == 0 || msg_id.second == 255
+            || layout_map.at(msg_class.first).at(msg_id.first).count
+              == layout::subframes)
+          continue;
+
+        double rate = bytes_per_second(msg_class.first, msg_id.first,
+            msg_id.second);
+
+        if (rate > largest_rate)
+        {
+          largest = &msg_id.second;
+          largest_rate = rate;
+        }
+      }
+
+    if (largest == nullptr)
+      break;
+
+    // Output half as often
+    *largest = static_cast<uint8_t>(std::min(255, 2 * *largest));
+
+    total = bytes_per_second(fitted);
+  }
+
+  return fitted;
+}
+
+rate_profile planner::plan(const rate_profile& profile, size_t& baud_rate,
+    size_t max_baud_rate, double max_utilization) const
+{
+  if (utilization(profile, baud_rate) <= max_utilization)
+    return profile;
+
+  size_t faster = this->baud_rate(profile, max_utilization, max_baud_rate);
+
+  if (faster != 0)
+  {
+    baud_rate = std::max(baud_rate, faster);
+
+    return profile;
+  }
+
+  baud_rate = std::max(baud_rate, max_baud_rate);
+
+  return fit(profile, baud_rate, max_utilization);
+}
+
+double planner::observed(const rate_profile& profile, uint64_t bytes,
+    double seconds) const
+{
+  const double predicted = bytes_per_second(profile);
+
+  if (predicted == 0 || seconds <= 0)
+    return 0;
+
+  return bytes / seconds / predicted;
+}
+
+} // namespace ubx
+
+} // namespace cracl
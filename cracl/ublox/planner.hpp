@@ -0,0 +1,128 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_PLANNER_HPP
+#define CRACL_UBLOX_PLANNER_HPP
+
+#include "msg/base.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Worst case size of a periodic message, as a fixed part plus a number
+ *        of repeated blocks (all sizes include framing)
+ */
+struct layout
+{
+  // What the number of repeated blocks scales with
+  enum count_type { none, satellites, signals, sentences, subframes };
+
+  size_t fixed;
+  size_t block;
+  count_type count;
+  size_t extra;
+};
+
+/* @brief Worst case layouts of messages commonly enabled for periodic output
+ */
+extern const std::map<std::string, std::map<std::string, layout>> layout_map;
+
+/* @brief Predicts the serial throughput of a message rate profile
+ *
+ * Rates follow CFG-MSG/CFG-MSGOUT semantics: a rate of N outputs the message
+ * once every N navigation solutions and 0 disables it. RXM-SFRBX is output as
+ * subframes are decoded, so its throughput depends on the signal count rather
+ * than the rate. Capacity assumes 10 bits on the wire per byte (8N1).
+ */
+class planner
+{
+  double m_nav_rate;
+  size_t m_satellites;
+  size_t m_signals;
+
+public:
+  /* @param nav_rate Navigation solutions per second
+   * @param satellites Most satellites expected to be tracked
+   * @param signals Most signals expected to be tracked
+   */
+  planner(double nav_rate=1, size_t satellites=40, size_t signals=80);
+
+  /* @brief Worst case bytes in one output of a message
+   */
+  size_t frame_size(const std::string& msg_class,
+      const std::string& msg_id) const;
+
+  double bytes_per_second(const std::string& msg_class,
+      const std::string& msg_id, uint8_t rate) const;
+
+  double bytes_per_second(const rate_profile& profile) const;
+
+  /* @brief Bytes per second a UART can carry at a baud rate
+   */
+  static double capacity(size_t baud_rate);
+
+  double utilization(const rate_profile& profile, size_t baud_rate) const;
+
+  /* @brief Smallest standard baud rate (up to max_baud_rate) that carries
+   *        the profile within max_utilization, or 0 if none does
+   */
+  size_t baud_rate(const rate_profile& profile, double max_utilization=0.8,
+      size_t max_baud_rate=921600) const;
+
+  /* @brief Reduce output rates, largest contributor first, until the profile
+   *        fits within max_utilization at a baud rate. The result may still
+   *        not fit if only messages whose rate can't be lowered remain
+   */
+  rate_profile fit(const rate_profile& profile, size_t baud_rate,
+      double max_utilization=0.8) const;
+
+  /* @brief Raise baud_rate as far as max_baud_rate if the profile doesn't
+   *        fit, then lower rates if it still doesn't
+   *
+   * @param baud_rate Current baud rate, updated to the rate to use
+   *
+   * @return Profile to apply at the returned baud rate
+   */
+  rate_profile plan(const rate_profile& profile, size_t& baud_rate,
+      size_t max_baud_rate=921600, double max_utilization=0.8) const;
+
+  /* @brief Compare measured throughput against the prediction, e.g. using
+   *        the difference in device::bytes_read() over an interval
+   *
+   * @return Measured rate as a fraction of the predicted worst case, values
+   *         above 1 mean the prediction was too optimistic
+   */
+  double observed(const rate_profile& profile, uint64_t bytes,
+      double seconds) const;
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_PLANNER_HPP
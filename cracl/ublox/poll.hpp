@@ -0,0 +1,103 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_POLL_HPP
+#define CRACL_UBLOX_POLL_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Responses to a batch of polls
+ */
+struct poll_result
+{
+  // One frame per request, in the order requested, empty if it didn't
+  //   arrive in time
+  std::vector<std::vector<uint8_t>> messages;
+
+  // Positions of the requests that timed out
+  std::vector<size_t> timed_out;
+
+  /* @brief True if every request was answered
+   */
+  bool complete() const;
+
+};
+
+/* @brief Responses to a batch of polls, parsed into the requested types
+ */
+template <typename... Messages>
+struct polled
+{
+  std::tuple<Messages...> values;
+
+  // True for each value that was received and parsed
+  std::array<bool, sizeof...(Messages)> received;
+
+  // Class and ID of each message that timed out
+  std::vector<std::pair<std::string, std::string>> timed_out;
+
+  polled(poll_result& raw)
+  {
+    received.fill(false);
+
+    parse(raw, std::index_sequence_for<Messages...>());
+
+    static const std::array<std::pair<const char*, const char*>,
+      sizeof...(Messages)> names{{{Messages::msg_class(),
+        Messages::msg_id()}...}};
+
+    for (size_t i : raw.timed_out)
+      timed_out.emplace_back(names[i].first, names[i].second);
+  }
+
+  template <typename T>
+  T& get() { return std::get<T>(values); }
+
+  bool complete() const { return timed_out.empty(); }
+
+private:
+  template <size_t... I>
+  void parse(poll_result& raw, std::index_sequence<I...>)
+  {
+    using expand = int[];
+
+    (void) expand{0, (raw.messages[I].empty() ? 0
+        : (std::get<I>(values).update(raw.messages[I]), received[I] = true,
+          0))...};
+  }
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_POLL_HPP
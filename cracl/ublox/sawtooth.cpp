@@ -0,0 +1,108 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "sawtooth.hpp"
+
+#include "msg/class/tim.hpp"
+#include "../base/pps.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+sawtooth::sawtooth(std::chrono::milliseconds max_lead)
+  : m_max_lead (max_lead), m_pending (false), m_corrected (0),
+  m_unmatched (0)
+{ }
+
+void sawtooth::announce(const tim::tp_view& tp,
+    pps::realtime::time_point arrival)
+{
+  if (m_pending)
+    ++m_unmatched;
+
+  m_next.week = tp.week();
+  m_next.towMS = tp.towMS();
+  m_next.towSubMS = tp.towSubMS();
+  m_next.utc_base = tp.timeBase() != 0;
+
+  m_next.qErr_valid = tp.qErrInvalid() == 0;
+  m_next.qErr = m_next.qErr_valid ? tp.qErr() : 0;
+
+  m_announced = arrival;
+  m_pending = true;
+}
+
+bool sawtooth::match(const pps::edge& pulse, corrected_pulse& result)
+{
+  if (!m_pending || !pulse.assert || pulse.real <= m_announced)
+    return false;
+
+  m_pending = false;
+
+  if (pulse.real - m_announced > m_max_lead)
+  {
+    ++m_unmatched;
+
+    return false;
+  }
+
+  result = m_next;
+  result.pulse = pulse;
+
+  // Picoseconds to the clock's resolution
+  result.corrected = pulse.real
+    - std::chrono::duration_cast<pps::realtime::duration>(
+        std::chrono::nanoseconds(std::llround(m_next.qErr * 1e-3)));
+
+  ++m_corrected;
+
+  return true;
+}
+
+bool sawtooth::pending() const
+{
+  return m_pending;
+}
+
+uint64_t sawtooth::corrected() const
+{
+  return m_corrected;
+}
+
+uint64_t sawtooth::unmatched() const
+{
+  return m_unmatched;
+}
+
+void sawtooth::clear()
+{
+  m_pending = false;
+}
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,115 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_SAWTOOTH_HPP
+#define CRACL_UBLOX_SAWTOOTH_HPP
+
+#include "msg/class/tim.hpp"
+#include "../base/pps.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief A PPS edge with the quantization error TIM-TP reported for it
+ *        removed
+ */
+struct corrected_pulse
+{
+  // Edge as timestamped by the host
+  pps::edge pulse;
+
+  // Time of the pulse from TIM-TP, in GNSS time (or UTC if utc_base)
+  uint16_t week;
+  uint32_t towMS;
+  uint32_t towSubMS;
+  bool utc_base;
+
+  // Quantization error in picoseconds, the pulse was output qErr after the
+  //   time it marks. Zero if the receiver flagged it invalid
+  int32_t qErr;
+  bool qErr_valid;
+
+  // Host timestamp of the edge with qErr removed
+  pps::realtime::time_point corrected;
+
+};
+
+/* @brief Matches each TIM-TP to the PPS edge it describes and removes the
+ *        quantization error (the sawtooth) from the edge's timestamp
+ *
+ * TIM-TP is output ahead of the pulse it describes, so one announcement is
+ * held until the next assert edge arrives. An edge later than max_lead after
+ * the announcement, or a second announcement before any edge, means the
+ * pulse was missed. Both steps are constant time.
+ */
+class sawtooth
+{
+  std::chrono::milliseconds m_max_lead;
+
+  bool m_pending;
+  pps::realtime::time_point m_announced;
+  corrected_pulse m_next;
+
+  uint64_t m_corrected;
+  uint64_t m_unmatched;
+
+public:
+  /* @param max_lead Longest time between a TIM-TP and its pulse
+   */
+  sawtooth(std::chrono::milliseconds max_lead=std::chrono::milliseconds(1000));
+
+  /* @brief Hold a TIM-TP (checksum already verified) until its pulse arrives
+   *
+   * @param arrival Host time the TIM-TP frame began arriving
+   */
+  void announce(const tim::tp_view& tp, pps::realtime::time_point arrival);
+
+  /* @brief Match an edge against the held TIM-TP. Edges from before the
+   *        announcement and clear edges are ignored
+   *
+   * @return True if result was filled in
+   */
+  bool match(const pps::edge& pulse, corrected_pulse& result);
+
+  /* @brief True if a TIM-TP is waiting for its pulse
+   */
+  bool pending() const;
+
+  uint64_t corrected() const;
+
+  /* @brief Announcements whose pulse never arrived
+   */
+  uint64_t unmatched() const;
+
+  void clear();
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_SAWTOOTH_HPP
@@ -0,0 +1,96 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "subscription.hpp"
+
+#include <functional>
+#include <utility>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+subscription::subscription()
+  : m_confirmed (false)
+{ }
+
+subscription::subscription(std::function<void()> release, bool confirmed)
+  : m_release (std::move(release)), m_confirmed (confirmed)
+{ }
+
+subscription::subscription(subscription&& other)
+  : m_release (std::move(other.m_release)), m_confirmed (other.m_confirmed)
+{
+  other.m_release = nullptr;
+}
+
+subscription& subscription::operator=(subscription&& other)
+{
+  if (this != &other)
+  {
+    reset();
+
+    m_release = std::move(other.m_release);
+    m_confirmed = other.m_confirmed;
+
+    other.m_release = nullptr;
+  }
+
+  return *this;
+}
+
+subscription::~subscription()
+{
+  // Releasing talks to the receiver, which mustn't escape a destructor
+  try
+  {
+    reset();
+  }
+  catch (...)
+  { }
+}
+
+void subscription::reset()
+{
+  if (!m_release)
+    return;
+
+  std::function<void()> release = std::move(m_release);
+
+  m_release = nullptr;
+
+  release();
+}
+
+bool subscription::active() const
+{
+  return static_cast<bool>(m_release);
+}
+
+bool subscription::confirmed() const
+{
+  return m_confirmed;
+}
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,80 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_SUBSCRIPTION_HPP
+#define CRACL_UBLOX_SUBSCRIPTION_HPP
+
+#include <functional>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief Interest in a message's periodic output, held for as long as the
+ *        handle lives. The receiver keeps outputting the message at the most
+ *        frequent rate any subscriber asked for, and returns to its earlier
+ *        rate once the last handle is released. Handles must be released on
+ *        the thread that reads the receiver; one released after the
+ *        receiver object is destroyed does nothing
+ */
+class subscription
+{
+  std::function<void()> m_release;
+
+  bool m_confirmed;
+
+public:
+  subscription();
+
+  /* @param release Called once when the handle is released
+   * @param confirmed Whether the receiver acknowledged the rate change
+   */
+  subscription(std::function<void()> release, bool confirmed);
+
+  subscription(subscription&& other);
+
+  subscription& operator=(subscription&& other);
+
+  subscription(const subscription&) = delete;
+
+  subscription& operator=(const subscription&) = delete;
+
+  ~subscription();
+
+  /* @brief Release the subscription now
+   */
+  void reset();
+
+  bool active() const;
+
+  /* @brief True if the receiver acknowledged the rate needed when
+   *        subscribing (an unacknowledged change is retried with the next)
+   */
+  bool confirmed() const;
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_SUBSCRIPTION_HPP
@@ -0,0 +1,157 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "time_mark.hpp"
+
+#include "timescale.hpp"
+#include "msg/class/tim.hpp"
+#include "../base/broadcast.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace
+{
+
+const int64_t ns_per_ms = 1000000;
+const int64_t ms_per_week = 604800000;
+
+// 1980-01-06 00:00 (the GPS epoch) in Unix nanoseconds
+const int64_t gps_epoch_ns = 315964800LL * 1000000000;
+
+} // namespace
+
+time_mark_stream::reader::reader(time_mark_stream& stream)
+  : m_cursor (stream.m_ring)
+{ }
+
+bool time_mark_stream::reader::next(time_mark& result)
+{
+  size_t size;
+
+  return m_cursor.next(reinterpret_cast<uint8_t*>(&result), sizeof (result),
+      size);
+}
+
+bool time_mark_stream::reader::wait(size_t timeout)
+{
+  return m_cursor.wait(timeout);
+}
+
+uint64_t time_mark_stream::reader::overruns() const
+{
+  return m_cursor.overruns();
+}
+
+time_mark_stream::time_mark_stream(size_t slots)
+  : m_ring (slots, sizeof (time_mark)), m_marks (0), m_missed (0)
+{
+  m_counts.fill(-1);
+}
+
+void time_mark_stream::decode(const tim::tm2_view& tm2, time_mark& result,
+    const timescale& scale)
+{
+  result.channel = tm2.ch();
+  result.count = tm2.count();
+
+  result.rising = tm2.newRisingEdge() != 0;
+  result.falling = tm2.newFallingEdge() != 0;
+
+  result.time_base = tm2.timeBase();
+  result.valid = tm2.time() != 0;
+
+  result.rising_ns = (tm2.wnR() * ms_per_week + tm2.towMsR()) * ns_per_ms
+    + tm2.towSubMsR();
+  result.falling_ns = (tm2.wnF() * ms_per_week + tm2.towMsF()) * ns_per_ms
+    + tm2.towSubMsF();
+
+  // On the UTC time base weeks count from the GPS epoch on UTC
+  if (result.time_base == 2)
+  {
+    result.rising_utc = result.rising_ns + gps_epoch_ns;
+    result.falling_utc = result.falling_ns + gps_epoch_ns;
+    result.utc_valid = true;
+  }
+  else
+    result.utc_valid = result.time_base == 1
+      && scale.gps_to_utc(result.rising_ns, result.rising_utc)
+      && scale.gps_to_utc(result.falling_ns, result.falling_utc);
+
+  if (!result.utc_valid)
+  {
+    result.rising_utc = 0;
+    result.falling_utc = 0;
+  }
+
+  result.accuracy = tm2.accEst();
+}
+
+void time_mark_stream::add(const tim::tm2_view& tm2, const timescale& scale,
+    time_mark::clock::time_point arrival)
+{
+  time_mark mark;
+
+  decode(tm2, mark, scale);
+
+  mark.arrival = arrival;
+  mark.missed = 0;
+
+  int32_t& last = m_counts[mark.channel];
+
+  if (mark.rising)
+  {
+    if (last >= 0)
+      mark.missed = static_cast<uint16_t>(mark.count - last - 1);
+
+    last = mark.count;
+  }
+
+  m_missed += mark.missed;
+  ++m_marks;
+
+  m_ring.publish(reinterpret_cast<const uint8_t*>(&mark), sizeof (mark),
+      arrival);
+}
+
+time_mark_stream::reader time_mark_stream::subscribe()
+{
+  return reader(*this);
+}
+
+uint64_t time_mark_stream::marks() const
+{
+  return m_marks;
+}
+
+uint64_t time_mark_stream::missed() const
+{
+  return m_missed;
+}
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,160 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_TIME_MARK_HPP
+#define CRACL_UBLOX_TIME_MARK_HPP
+
+#include "timescale.hpp"
+#include "msg/class/tim.hpp"
+#include "../base/broadcast.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief One TIM-TM2 decoded into nanosecond times
+ */
+struct time_mark
+{
+  typedef std::chrono::system_clock clock;
+
+  // EXTINT channel and its rising edge counter
+  uint8_t channel;
+  uint16_t count;
+
+  // Rising edges between the previous mark on the channel and this one that
+  //   were never reported
+  uint16_t missed;
+
+  // Whether each edge is new since the previous mark
+  bool rising;
+  bool falling;
+
+  // 0 receiver, 1 GNSS (GPS grid), 2 UTC
+  uint8_t time_base;
+
+  // True if the receiver had a valid time when the edges were marked
+  bool valid;
+
+  // Edges in nanoseconds since 1980-01-06 00:00 on the time base
+  int64_t rising_ns;
+  int64_t falling_ns;
+
+  // Edges in nanoseconds since the Unix epoch (UTC), if utc_valid
+  int64_t rising_utc;
+  int64_t falling_utc;
+  bool utc_valid;
+
+  // Accuracy estimate in nanoseconds
+  uint32_t accuracy;
+
+  // Host time the TIM-TM2 frame began arriving
+  clock::time_point arrival;
+
+};
+
+/* @brief Bounded ring of time marks from TIM-TM2, delivered to any number of
+ *        readers with the host arrival time of each message
+ *
+ * Marks are fixed size and held in slots allocated up front, so nothing is
+ * allocated per event. Edges the receiver never reported (more than one
+ * edge per navigation epoch, or a lost message) are counted from the
+ * message's edge counter.
+ */
+class time_mark_stream
+{
+  broadcast m_ring;
+
+  // Last rising edge count seen on each channel, -1 before the first
+  std::array<int32_t, 256> m_counts;
+
+  uint64_t m_marks;
+  uint64_t m_missed;
+
+public:
+  class reader
+  {
+    broadcast::cursor m_cursor;
+
+  public:
+    reader(time_mark_stream& stream);
+
+    /* @brief Copy out the next mark
+     *
+     * @return False if no new mark has arrived
+     */
+    bool next(time_mark& result);
+
+    /* @brief Block until a mark arrives or the timeout (in milliseconds)
+     *        expires
+     */
+    bool wait(size_t timeout);
+
+    /* @brief Marks skipped because the reader fell a ring behind
+     */
+    uint64_t overruns() const;
+
+  };
+
+  /* @param slots Number of marks held for readers
+   */
+  time_mark_stream(size_t slots=1024);
+
+  time_mark_stream(const time_mark_stream&) = delete;
+
+  time_mark_stream& operator=(const time_mark_stream&) = delete;
+
+  /* @brief Decode a TIM-TM2 (checksum already verified). The missed count
+   *        and arrival are left alone
+   *
+   * @param scale Leap seconds for the UTC times of marks on the GNSS time
+   *        base, which have none until it has learned them
+   */
+  static void decode(const tim::tm2_view& tm2, time_mark& result,
+      const timescale& scale);
+
+  /* @brief Decode a TIM-TM2 and publish it to readers (single producer)
+   */
+  void add(const tim::tm2_view& tm2, const timescale& scale,
+      time_mark::clock::time_point arrival=time_mark::clock::now());
+
+  reader subscribe();
+
+  /* @brief Marks published so far
+   */
+  uint64_t marks() const;
+
+  /* @brief Rising edges the receiver never reported, over all channels
+   */
+  uint64_t missed() const;
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_TIME_MARK_HPP
@@ -0,0 +1,369 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include "timescale.hpp"
+
+#include "msg/base.hpp"
+#include "msg/class/nav.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+namespace
+{
+
+const int64_t ns_per_s = 1000000000;
+const int64_t ns_per_ms = 1000000;
+const int64_t ns_per_week = 604800 * ns_per_s;
+
+// 1980-01-06 00:00 UTC (the GPS epoch) in Unix seconds
+const int64_t gps_epoch = 315964800;
+
+// GPS weeks at the start of Galileo and BeiDou week 0, and BDT behind GPS
+const int64_t galileo_week = 1024;
+const int64_t beidou_week = 1356;
+const int64_t beidou_offset = 14;
+
+// GLONASS 4 year intervals count from 1996-01-01 (Unix day 9496), its time
+//   is UTC(SU) + 3 hours
+const int64_t glonass_epoch_days = 9496;
+const int64_t glonass_offset = 3 * 3600;
+
+} // namespace
+
+int64_t unix_seconds(int year, int month, int day, int hour, int min,
+    int sec)
+{
+  // Days from civil, counting years from March so leap days come last
+  const int64_t y = year - (month <= 2);
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const int64_t yoe = y - era * 400;
+  const int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day
+    - 1;
+  const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  const int64_t days = era * 146097 + doe - 719468;
+
+  return days * 86400 + hour * 3600 + min * 60 + sec;
+}
+
+timespec to_timespec(int64_t ns)
+{
+  int64_t s = ns / ns_per_s;
+  int64_t rem = ns % ns_per_s;
+
+  if (rem < 0)
+  {
+    --s;
+    rem += ns_per_s;
+  }
+
+  timespec result;
+
+  result.tv_sec = static_cast<time_t>(s);
+  result.tv_nsec = static_cast<long>(rem);
+
+  return result;
+}
+
+timescale::timescale()
+{
+  clear();
+}
+
+void timescale::learn_leap(int leap_seconds)
+{
+  // Reporting the new value means an announced change has taken effect
+  if (m_change_known && leap_seconds == m_leap_seconds + m_change)
+    m_change_known = false;
+
+  m_leap_seconds = leap_seconds;
+  m_leap_known = true;
+}
+
+int timescale::leap_at(int64_t gps) const
+{
+  return m_change_known && gps >= m_change_gps
+    ? m_leap_seconds + m_change : m_leap_seconds;
+}
+
+void timescale::from_gps(instant& result) const
+{
+  result.utc_valid = result.gps_valid && m_leap_known;
+  result.utc = m_leap_known
+    ? result.gps + (gps_epoch - leap_at(result.gps)) * ns_per_s : 0;
+}
+
+void timescale::from_utc(instant& result) const
+{
+  const int64_t guess = result.utc - (gps_epoch - m_leap_seconds) * ns_per_s;
+
+  result.gps_valid = result.utc_valid && m_leap_known;
+  result.gps = m_leap_known
+    ? result.utc - (gps_epoch - leap_at(guess)) * ns_per_s : 0;
+}
+
+const instant& timescale::seen(const instant& result)
+{
+  if (result.gps_valid)
+  {
+    m_last_gps = result.gps;
+    m_time_known = true;
+  }
+
+  return result;
+}
+
+instant timescale::gps(const nav::timegps_view& time)
+{
+  if (time.leapSValid())
+    learn_leap(time.leapS());
+
+  instant result;
+
+  result.gps = time.week() * ns_per_week + time.iTOW() * ns_per_ms
+    + time.fTOD();
+  result.gps_valid = time.towValid() && time.weekValid();
+  result.accuracy = time.tAcc();
+
+  from_gps(result);
+
+  return seen(result);
+}
+
+instant timescale::galileo(const nav::timegal_view& time)
+{
+  // GST - UTC is the same as GPS - UTC
+  if (time.leapSValid())
+    learn_leap(time.leapS());
+
+  instant result;
+
+  result.gps = (time.galWno() + galileo_week) * ns_per_week
+    + time.galTow() * ns_per_s + time.fGalTow();
+  result.gps_valid = time.galTowValid() && time.galWnoValid();
+  result.accuracy = time.tAcc();
+
+  from_gps(result);
+
+  return seen(result);
+}
+
+instant timescale::beidou(const nav::timebds_view& time)
+{
+  if (time.leapSValid())
+    learn_leap(time.leapS() + beidou_offset);
+
+  instant result;
+
+  result.gps = (time.week() + beidou_week) * ns_per_week
+    + (time.sow() + beidou_offset) * ns_per_s + time.fSOW();
+  result.gps_valid = time.sowValid() && time.weekValid();
+  result.accuracy = time.tAcc();
+
+  from_gps(result);
+
+  return seen(result);
+}
+
+instant timescale::glonass(const nav::timeglo_view& time)
+{
+  instant result;
+
+  const int64_t days = glonass_epoch_days + 1461 * (time.n4() - 1)
+    + time.nt() - 1;
+
+  result.utc = (days * 86400 + time.tod() - glonass_offset) * ns_per_s
+    + time.fTOD();
+  result.utc_valid = time.todValid() && time.dateValid();
+  result.accuracy = time.tAcc();
+
+  from_utc(result);
+
+  return seen(result);
+}
+
+instant timescale::utc(const nav::timeutc_view& time)
+{
+  const uint32_t date = static_cast<uint32_t>(time.year()) << 16
+    | time.month() << 8 | time.day();
+
+  if (date != m_date)
+  {
+    m_date = date;
+    m_date_days = unix_seconds(time.year(), time.month(), time.day(), 0, 0,
+        0) / 86400;
+  }
+
+  instant result;
+
+  result.utc = (m_date_days * 86400 + time.hour() * 3600 + time.min() * 60
+      + time.sec()) * ns_per_s + time.nano();
+  result.utc_valid = time.validTOW() && time.validWKN() && time.validUTC();
+  result.accuracy = time.tAcc();
+
+  from_utc(result);
+
+  return seen(result);
+}
+
+void timescale::leap_seconds(const nav::timels_view& leaps)
+{
+  if (leaps.validCurrLs())
+    learn_leap(leaps.currLs());
+
+  if (!leaps.validTimeToLsEvent())
+    return;
+
+  // Only a change still to come matters, a past one is part of currLs
+  if (leaps.lsChange() == 0 || leaps.timeToLsEvent() <= 0 || !m_time_known)
+  {
+    m_change_known = false;
+
+    return;
+  }
+
+  // Place the message's time of week in the week of the latest time seen
+  const int64_t tow = leaps.iTOW() * ns_per_ms;
+  int64_t now = m_last_gps - m_last_gps % ns_per_week + tow;
+
+  if (now < m_last_gps - ns_per_week / 2)
+    now += ns_per_week;
+  else if (now > m_last_gps + ns_per_week / 2)
+    now -= ns_per_week;
+
+  m_change = leaps.lsChange();
+  m_change_gps = now + leaps.timeToLsEvent() * ns_per_s;
+  m_change_known = true;
+}
+
+bool timescale::convert(const std::vector<uint8_t>& message, instant& result)
+{
+  static const auto& nav = ubx::msg_map.at("NAV");
+  static const uint8_t nav_timegps = nav.second.at("TIMEGPS");
+  static const uint8_t nav_timegal = nav.second.at("TIMEGAL");
+  static const uint8_t nav_timebds = nav.second.at("TIMEBDS");
+  static const uint8_t nav_timeglo = nav.second.at("TIMEGLO");
+  static const uint8_t nav_timeutc = nav.second.at("TIMEUTC");
+  static const uint8_t nav_timels = nav.second.at("TIMELS");
+
+  if (message.size() < 8 || message[2] != nav.first)
+    return false;
+
+  const uint8_t id = message[3];
+
+  if (id == nav_timegps && message.size() == 24)
+    result = gps(nav::timegps_view(message));
+  else if (id == nav_timegal && message.size() == 28)
+    result = galileo(nav::timegal_view(message));
+  else if (id == nav_timebds && message.size() == 28)
+    result = beidou(nav::timebds_view(message));
+  else if (id == nav_timeglo && message.size() == 28)
+    result = glonass(nav::timeglo_view(message));
+  else if (id == nav_timeutc && message.size() == 28)
+    result = utc(nav::timeutc_view(message));
+  else
+  {
+    if (id == nav_timels && message.size() == 32)
+      leap_seconds(nav::timels_view(message));
+
+    return false;
+  }
+
+  return true;
+}
+
+size_t timescale::convert(std::vector<std::vector<uint8_t>>& messages,
+    std::vector<instant>& results)
+{
+  results.assign(messages.size(), instant());
+
+  size_t converted = 0;
+
+  for (size_t i = 0; i < messages.size(); ++i)
+    if (valid_checksum(messages[i]) && convert(messages[i], results[i]))
+      ++converted;
+
+  return converted;
+}
+
+bool timescale::gps_to_utc(int64_t gps, int64_t& utc) const
+{
+  if (!m_leap_known)
+    return false;
+
+  utc = gps + (gps_epoch - leap_at(gps)) * ns_per_s;
+
+  return true;
+}
+
+bool timescale::utc_to_gps(int64_t utc, int64_t& gps) const
+{
+  if (!m_leap_known)
+    return false;
+
+  instant t;
+
+  t.utc = utc;
+  t.utc_valid = true;
+
+  from_utc(t);
+
+  gps = t.gps;
+
+  return true;
+}
+
+int timescale::leap_seconds() const
+{
+  return m_leap_known ? m_leap_seconds : -1;
+}
+
+int timescale::pending_change(int64_t gps, int64_t within) const
+{
+  return m_change_known && gps < m_change_gps
+    && m_change_gps - gps <= within ? m_change : 0;
+}
+
+void timescale::clear()
+{
+  m_leap_known = false;
+  m_leap_seconds = 0;
+
+  m_change_known = false;
+  m_change = 0;
+  m_change_gps = 0;
+
+  m_time_known = false;
+  m_last_gps = 0;
+
+  m_date = 0;
+  m_date_days = 0;
+}
+
+} // namespace ubx
+
+} // namespace cracl
@@ -0,0 +1,167 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#ifndef CRACL_UBLOX_TIMESCALE_HPP
+#define CRACL_UBLOX_TIMESCALE_HPP
+
+#include "msg/class/nav.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace cracl
+{
+
+namespace ubx
+{
+
+/* @brief A time from any of the NAV-TIME* messages on a common timeline
+ */
+struct instant
+{
+  // Nanoseconds since 1980-01-06 00:00 on GPS time
+  int64_t gps;
+
+  // Nanoseconds since the Unix epoch on UTC (leap seconds not counted)
+  int64_t utc;
+
+  // True if the message's time (including week or date) was valid, and the
+  //   leap seconds needed to reach the other timeline were known
+  bool gps_valid;
+  bool utc_valid;
+
+  // Accuracy estimate in nanoseconds
+  uint32_t accuracy;
+
+};
+
+/* @brief Seconds since the Unix epoch of a UTC calendar date and time
+ */
+int64_t unix_seconds(int year, int month, int day, int hour, int min,
+    int sec);
+
+/* @brief Split nanoseconds since an epoch into a timespec
+ */
+timespec to_timespec(int64_t ns);
+
+/* @brief Converts the times of NAV-TIMEGPS, TIMEGAL, TIMEBDS, TIMEGLO and
+ *        TIMEUTC to GPS and UTC nanoseconds
+ *
+ * Leap seconds are learned from the messages that carry them (and from
+ * NAV-TIMELS, including an announced change, which is applied from the
+ * moment it takes effect). Each conversion is a few multiplies and adds;
+ * the day number of the last TIMEUTC date is cached so calendar arithmetic
+ * is only done when the date changes.
+ */
+class timescale
+{
+  // GPS - UTC in seconds, before and after the announced change
+  bool m_leap_known;
+  int m_leap_seconds;
+
+  bool m_change_known;
+  int m_change;
+  int64_t m_change_gps;
+
+  // Latest valid GPS time converted, to place the iTOW of NAV-TIMELS
+  bool m_time_known;
+  int64_t m_last_gps;
+
+  // Last TIMEUTC date and its day number
+  uint32_t m_date;
+  int64_t m_date_days;
+
+  void learn_leap(int leap_seconds);
+
+  int leap_at(int64_t gps) const;
+
+  /* @brief Fill in the UTC side of a time known on GPS, or the reverse
+   */
+  void from_gps(instant& result) const;
+
+  void from_utc(instant& result) const;
+
+  /* @brief Keep a valid result as the latest time seen
+   */
+  const instant& seen(const instant& result);
+
+public:
+  timescale();
+
+  instant gps(const nav::timegps_view& time);
+
+  instant galileo(const nav::timegal_view& time);
+
+  instant beidou(const nav::timebds_view& time);
+
+  instant glonass(const nav::timeglo_view& time);
+
+  instant utc(const nav::timeutc_view& time);
+
+  /* @brief Learn the current leap seconds and any announced change
+   */
+  void leap_seconds(const nav::timels_view& leaps);
+
+  /* @brief Convert any NAV-TIME* message (checksum already verified),
+   *        NAV-TIMELS is learned from
+   *
+   * @return False if the message doesn't carry a time
+   */
+  bool convert(const std::vector<uint8_t>& message, instant& result);
+
+  /* @brief Convert a recorded log in order. Each frame's result is written
+   *        to the same position, frames without a time (or with a bad
+   *        checksum) are left with neither time valid
+   *
+   * @return Number of frames converted
+   */
+  size_t convert(std::vector<std::vector<uint8_t>>& messages,
+      std::vector<instant>& results);
+
+  /* @brief UTC nanoseconds of a GPS time, using the leap seconds in effect
+   *        at that time
+   *
+   * @return False if the leap seconds aren't known yet
+   */
+  bool gps_to_utc(int64_t gps, int64_t& utc) const;
+
+  bool utc_to_gps(int64_t utc, int64_t& gps) const;
+
+  /* @brief GPS - UTC in seconds now, negative until learned
+   */
+  int leap_seconds() const;
+
+  /* @brief Seconds (+1 or -1) of an announced leap second taking effect
+   *        after the given GPS time and no more than within nanoseconds
+   *        later (a day by default), 0 if none
+   */
+  int pending_change(int64_t gps,
+      int64_t within=86400 * static_cast<int64_t>(1000000000)) const;
+
+  void clear();
+
+};
+
+} // namespace ubx
+
+} // namespace cracl
+
+#endif // CRACL_UBLOX_TIMESCALE_HPP
@@ -90,7 +90,7 @@ int main(int argc, char* argv[])
 
     for (size_t i = 0; i < parsed.numSvs(); ++i)
     {
-      switch (parsed.gnssId()[i])
+      switch (parsed.gnssId(i))
       {
         case 0: std::cout << "\t    GPS "; break;
         case 1: std::cout << "\t   SBAS "; break;
@@ -101,13 +101,13 @@ int main(int argc, char* argv[])
         case 6: std::cout << "\tGLONASS "; break;
       }
 
-      std::cout << (int)parsed.svId()[i]
-        << "\t\tUsed: " << (int)parsed.svUsed()[i]
-        << "\t\tCNO: " << (int)parsed.cno()[i]
-        << "\t\tResidual: " << ((int)parsed.prRes()[i] / 10.0)
+      std::cout << (int)parsed.svId(i)
+        << "\t\tUsed: " << (int)parsed.svUsed(i)
+        << "\t\tCNO: " << (int)parsed.cno(i)
+        << "\t\tResidual: " << ((int)parsed.prRes(i) / 10.0)
         << "\t\tQuality: ";
 
-      switch (parsed.qualityInd()[i])
+      switch (parsed.qualityInd(i))
       {
         case 0: std::cout << "No Signal "; break;
         case 1: std::cout << "Searching"; break;
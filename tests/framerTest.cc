@@ -0,0 +1,165 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include <cracl/base/nmea.hpp>
+#include <cracl/ublox/m8.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+// Append the *hh checksum and line ending to a sentence body ($ to last field)
+static std::string checksummed(const std::string& body)
+{
+  uint8_t sum = 0;
+
+  for (size_t i = 1; i < body.size(); ++i)
+    sum ^= body[i];
+
+  char hex[3];
+  std::snprintf(hex, sizeof(hex), "%02X", sum);
+
+  return body + "*" + hex + "\r\n";
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace cracl;
+
+  // A pseudo-terminal stands in for the receiver
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+  {
+    std::cerr << "Unable to open pseudo-terminal" << std::endl;
+    return 1;
+  }
+
+  m8 x(ptsname(master));
+
+  // PUBX,00 with every field at its widest, well past the 82 char NMEA limit
+  const std::string pubx = checksummed("$PUBX,00,235959.99,8959.99999,S,"
+      "17959.99999,W,-12345.678,DR,99999.9,99999.9,99999.999,359.99,"
+      "-9999.999,9999,99.99,99.99,99.99,99,0,0");
+
+  // PUBX,03 for every channel of a 72 channel receiver, at its widest
+  std::string body = "$PUBX,03,72";
+
+  for (int i = 1; i <= 72; ++i)
+  {
+    char block[32];
+    std::snprintf(block, sizeof(block), ",%03d,U,359,-89,45,064", i);
+
+    body += block;
+  }
+
+  const std::string svstatus = checksummed(body);
+
+  const std::string gga = checksummed("$GNGGA,000000.00,,,,,0,00,99.99,,,,,,");
+
+  // The sentence after them must still be aligned
+  const std::string stream = pubx + svstatus + gga;
+
+  if (::write(master, stream.data(), stream.size())
+      != static_cast<ssize_t>(stream.size()))
+  {
+    std::cerr << "Unable to write to pseudo-terminal" << std::endl;
+    return 1;
+  }
+
+  int failures = 0;
+
+  x.buffer_messages();
+
+  if (x.nmea_queued() != 3)
+  {
+    std::cout << "Expected 3 sentences, framed " << x.nmea_queued()
+      << std::endl;
+    return 1;
+  }
+
+  auto framed = x.fetch_nmea();
+  std::string text(framed.begin(), framed.end());
+
+  std::cout << "PUBX,00 (" << pubx.size() - 2 << " chars): ";
+
+  if (text != pubx.substr(0, pubx.size() - 2))
+  {
+    std::cout << "framed as " << text << std::endl;
+    ++failures;
+  }
+  else
+  {
+    nmea::pubx::position position;
+
+    if (!position.update(framed))
+    {
+      std::cout << "framed but not parsed" << std::endl;
+      ++failures;
+    }
+    else
+      std::cout << "OK, numSvs " << static_cast<int>(position.numSvs())
+        << std::endl;
+  }
+
+  framed = x.fetch_nmea();
+  text.assign(framed.begin(), framed.end());
+
+  std::cout << "PUBX,03 (" << svstatus.size() - 2 << " chars): ";
+
+  if (text != svstatus.substr(0, svstatus.size() - 2))
+  {
+    std::cout << "framed as " << text << std::endl;
+    ++failures;
+  }
+  else
+  {
+    nmea::pubx::svstatus satellites;
+
+    if (!satellites.update(framed) || satellites.n() != 72
+        || satellites.sat(71).sv != 72 || satellites.sat(71).lck != 64)
+    {
+      std::cout << "framed but not parsed" << std::endl;
+      ++failures;
+    }
+    else
+      std::cout << "OK, " << satellites.n() << " satellites" << std::endl;
+  }
+
+  framed = x.fetch_nmea();
+  text.assign(framed.begin(), framed.end());
+
+  std::cout << "GNGGA following them: ";
+
+  if (text != gga.substr(0, gga.size() - 2))
+  {
+    std::cout << "framed as " << text << std::endl;
+    ++failures;
+  }
+  else
+    std::cout << "OK" << std::endl;
+
+  ::close(master);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include <cracl/rtcm/frame.hpp>
+#include <cracl/rtcm/msm.hpp>
+#include <cracl/ublox/msg/class/rxm.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Reads fields MSB first, the inverse of rtcm::bit_writer
+class bit_reader
+{
+  const uint8_t* m_data;
+  size_t m_bits;
+
+public:
+  bit_reader(const uint8_t* data) : m_data(data), m_bits(0) { }
+
+  uint64_t get(size_t bits)
+  {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < bits; ++i, ++m_bits)
+      value = value << 1 | (m_data[m_bits / 8] >> (7 - m_bits % 8) & 1);
+
+    return value;
+  }
+
+  int64_t get_signed(size_t bits)
+  {
+    const uint64_t value = get(bits);
+
+    if (bits < 64 && value >> (bits - 1))
+      return static_cast<int64_t>(value) - (int64_t(1) << bits);
+
+    return static_cast<int64_t>(value);
+  }
+};
+
+// One RXM-RAWX measurement block
+struct measurement
+{
+  double prMes;
+  double cpMes;
+  float doMes;
+  uint8_t gnssId;
+  uint8_t svId;
+  uint8_t sigId;
+  uint16_t locktime;
+  uint8_t cno;
+  uint8_t trkStat;
+};
+
+// RXM-RAWX frame (checksum left zero, the encoder doesn't check it)
+static std::vector<uint8_t> rawx(double rcvTow, uint16_t week, int8_t leapS,
+    const std::vector<measurement>& meas)
+{
+  std::vector<uint8_t> frame(8 + 16 + 32 * meas.size());
+
+  const uint16_t length = frame.size() - 8;
+
+  frame[0] = 0xb5;
+  frame[1] = 0x62;
+  frame[2] = 0x02;
+  frame[3] = 0x15;
+  std::memcpy(&frame[4], &length, 2);
+  std::memcpy(&frame[6], &rcvTow, 8);
+  std::memcpy(&frame[14], &week, 2);
+  frame[16] = leapS;
+  frame[17] = meas.size();
+
+  for (size_t i = 0; i < meas.size(); ++i)
+  {
+    uint8_t* block = &frame[22 + 32 * i];
+
+    std::memcpy(block, &meas[i].prMes, 8);
+    std::memcpy(block + 8, &meas[i].cpMes, 8);
+    std::memcpy(block + 16, &meas[i].doMes, 4);
+    block[20] = meas[i].gnssId;
+    block[21] = meas[i].svId;
+    block[22] = meas[i].sigId;
+    std::memcpy(block + 24, &meas[i].locktime, 2);
+    block[26] = meas[i].cno;
+    block[30] = meas[i].trkStat;
+  }
+
+  return frame;
+}
+
+static int failures = 0;
+
+static void check(const std::string& what, int64_t value, int64_t expected)
+{
+  if (value != expected)
+  {
+    std::cout << what << ": " << value << ", expected " << expected
+      << std::endl;
+
+    ++failures;
+  }
+}
+
+static void check_near(const std::string& what, double value, double expected,
+    double tolerance)
+{
+  if (!(std::fabs(value - expected) <= tolerance))
+  {
+    std::cout << what << ": " << value << ", expected " << expected
+      << std::endl;
+
+    ++failures;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace cracl;
+
+  const double c = 299792458.0;
+  const double range_ms = c * 1e-3;
+
+  // CRC-24Q check value
+  const char* digits = "123456789";
+
+  check("CRC-24Q of 123456789", rtcm::crc24q(
+        reinterpret_cast<const uint8_t*>(digits), 9), 0xcde703);
+
+  // GPS SV 5 on L1C/A (half cycle resolved) and L2 CL (unresolved)
+  const std::vector<measurement> meas = {
+    { 22000123.456, 115612345.678, -1234.5f, 0, 5, 0, 5000, 45, 0x07 },
+    { 22000125.0, 90088888.25, -961.9f, 0, 5, 3, 3000, 40, 0x03 }
+  };
+
+  const double wavelength[] = { c / 1575.42e6, c / 1227.60e6 };
+
+  const std::vector<uint8_t> frame = rawx(345600.0, 2200, 18, meas);
+  ubx::rxm::rawx_view view(frame);
+
+  rtcm::msm_encoder encoder(1234, rtcm::msm_encoder::msm7);
+
+  std::vector<uint8_t> out(2048);
+
+  const size_t size = encoder.encode(view, out.data(), out.size());
+
+  // A single MSM7 frame for the one constellation
+  check("MSM frame size", size,
+      rtcm::header_size + rtcm::payload_length(out.data()) + rtcm::crc_size);
+
+  std::vector<uint8_t> msm(out.begin(), out.begin() + size);
+
+  check("MSM CRC", rtcm::valid(msm), 1);
+  check("MSM message number", rtcm::message_number(msm), 1077);
+
+  bit_reader bits(msm.data() + rtcm::header_size);
+
+  check("DF002 message number", bits.get(12), 1077);
+  check("DF003 station", bits.get(12), 1234);
+  check("DF004 GPS epoch time", bits.get(30), 345600000);
+  check("DF393 multiple message", bits.get(1), 0);
+  bits.get(3 + 7 + 2 + 2 + 1 + 3);
+
+  check("DF394 satellite mask", bits.get(64), int64_t(1) << (64 - 5));
+  check("DF395 signal mask", bits.get(32),
+      (int64_t(1) << (32 - 2)) | (int64_t(1) << (32 - 16)));
+  check("DF396 cell mask", bits.get(2), 0x3);
+
+  const int64_t rough_ms = bits.get(8);
+  check("extended satellite info", bits.get(4), 0);
+  const int64_t rough_fraction = bits.get(10);
+  const int64_t rough_rate = bits.get_signed(14);
+
+  const double rough = rough_ms + rough_fraction / 1024.0;
+
+  check_near("DF397/DF398 rough range", rough, meas[0].prMes / range_ms,
+      1.0 / 2048);
+  check("DF399 rough range rate", rough_rate,
+      std::llround(-meas[0].doMes * wavelength[0]));
+
+  int64_t fine_range[2];
+  int64_t fine_phase[2];
+
+  for (size_t i = 0; i < 2; ++i)
+    fine_range[i] = bits.get_signed(20);
+
+  for (size_t i = 0; i < 2; ++i)
+    fine_phase[i] = bits.get_signed(24);
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const std::string cell = " (cell " + std::to_string(i) + ")";
+
+    // Within the field's resolution of the pseudorange
+    check_near("DF405 fine pseudorange" + cell,
+        (rough + std::ldexp(fine_range[i], -29)) * range_ms, meas[i].prMes,
+        std::ldexp(1, -29) * range_ms);
+
+    // Carrier phase is shifted by a whole number of cycles only
+    const double cycles = (rough + std::ldexp(fine_phase[i], -31)) * range_ms
+      / wavelength[i] - meas[i].cpMes;
+
+    check_near("DF406 fine phase range" + cell, cycles - std::round(cycles),
+        0, 1e-3);
+  }
+
+  // Lock times of 5000 and 3000 ms, in steps of 128 and 64 ms
+  check("DF407 lock time (cell 0)", bits.get(10), 263);
+  check("DF407 lock time (cell 1)", bits.get(10), 238);
+
+  check("DF420 half cycle (cell 0)", bits.get(1), 0);
+  check("DF420 half cycle (cell 1)", bits.get(1), 1);
+
+  check("DF408 CNR (cell 0)", bits.get(10), 45 * 16);
+  check("DF408 CNR (cell 1)", bits.get(10), 40 * 16);
+
+  for (size_t i = 0; i < 2; ++i)
+    check_near("DF404 fine range rate (cell " + std::to_string(i) + ")",
+        rough_rate + bits.get_signed(15) * 0.0001,
+        -meas[i].doMes * wavelength[i], 0.0001);
+
+  // Station position
+  const size_t station_size = encoder.encode_station(1234567.8901,
+      -2345678.9012, 5432109.8765, out.data(), out.size());
+
+  std::vector<uint8_t> station(out.begin(), out.begin() + station_size);
+
+  check("1005 CRC", rtcm::valid(station), 1);
+
+  bit_reader fields(station.data() + rtcm::header_size);
+
+  check("1005 DF002 message number", fields.get(12), 1005);
+  check("1005 DF003 station", fields.get(12), 1234);
+  fields.get(6 + 4);
+  check("DF025 ECEF X", fields.get_signed(38), 12345678901);
+  fields.get(2);
+  check("DF026 ECEF Y", fields.get_signed(38), -23456789012);
+  fields.get(2);
+  check("DF027 ECEF Z", fields.get_signed(38), 54321098765);
+
+  std::cout << (failures == 0 ? "OK" : "FAILED") << std::endl;
+
+  return failures;
+}
@@ -32,16 +32,21 @@ int main(int argc, char* argv[])
   // Disable NMEA messages on uBlox
   x.disable_nmea();
 
-  //BDS Demo
-  std::cout << "TIMEBDS Demo" << std::endl;
-  x.ubx_send("NAV", "TIMEBDS");
-  sleep(2);
+  // Poll every time message in one write, answered within an epoch
+  auto times = x.poll_many<ubx::nav::timebds, ubx::nav::timegal,
+    ubx::nav::timeglo, ubx::nav::timegps, ubx::nav::timeutc>(2000);
+
+  for (const auto& missing : times.timed_out)
+    std::cout << missing.first << "-" << missing.second << " timed out"
+      << std::endl;
 
-  auto nav_timebds = x.fetch_ubx("NAV", "TIMEBDS");
+  std::cout << std::endl;
 
-  if (ubx::nav::timebds::type(nav_timebds))
+  //BDS Demo
+  std::cout << "TIMEBDS Demo" << std::endl;
+  if (times.received[0])
   {
-    ubx::nav::timebds parsed = ubx::nav::timebds(nav_timebds);
+    ubx::nav::timebds& parsed = times.get<ubx::nav::timebds>();
 
     std::cout << "iTOW: " << parsed.iTOW() << "ms" << std::endl;
     std::cout << "SOW: " << parsed.sow() << "s" << std::endl;
@@ -60,19 +65,14 @@ int main(int argc, char* argv[])
     std::cout << "tAcc: " << parsed.tAcc() << "ns" << std::endl;
     std::cout << std::endl;
   }
-  else std::cout << "Type error" << std::endl;
+  else std::cout << "Not received" << std::endl;
   //BDS Demo End
 
   //GAL Demo
   std::cout << "TIMEGAL Demo" << std::endl;
-  x.ubx_send("NAV", "TIMEGAL");
-  sleep(2);
-
-  auto nav_timegal = x.fetch_ubx("NAV", "TIMEGAL");
-
-  if (ubx::nav::timegal::type(nav_timegal))
+  if (times.received[1])
   {
-    ubx::nav::timegal parsed = ubx::nav::timegal(nav_timegal);
+    ubx::nav::timegal& parsed = times.get<ubx::nav::timegal>();
 
     std::cout << "iTOW: " << parsed.iTOW() << "ms" << std::endl;
     std::cout << "galTow: " << parsed.galTow() << "s" << std::endl;
@@ -91,19 +91,14 @@ int main(int argc, char* argv[])
     std::cout << "tAcc: " << parsed.tAcc() << "ns" << std::endl;
     std::cout << std::endl;
   }
-  else std::cout << "Type error" << std::endl;
+  else std::cout << "Not received" << std::endl;
   //GAL Demo End
 
   //GLO Demo
   std::cout << "TIMEGLO Demo" << std::endl;
-  x.ubx_send("NAV", "TIMEGLO");
-  sleep(2);
-
-  auto nav_timeglo = x.fetch_ubx("NAV", "TIMEGLO");
-
-  if (ubx::nav::timeglo::type(nav_timeglo))
+  if (times.received[2])
   {
-    ubx::nav::timeglo parsed = ubx::nav::timeglo(nav_timeglo);
+    ubx::nav::timeglo& parsed = times.get<ubx::nav::timeglo>();
 
     std::cout << "iTOW: " << parsed.iTOW() << "ms" << std::endl;
     std::cout << "tod: " << parsed.tod() << "s" << std::endl;
@@ -119,19 +114,14 @@ int main(int argc, char* argv[])
     std::cout << "tAcc: " << parsed.tAcc() << "ns" << std::endl;
     std::cout << std::endl;
   }
-  else std::cout << "Type error" << std::endl;
+  else std::cout << "Not received" << std::endl;
   //GLO Demo End
 
   //GPS Demo
   std::cout << "TIMEGPS Demo" << std::endl;
-  x.ubx_send("NAV", "TIMEGPS");
-  sleep(2);
-
-  auto nav_timegps = x.fetch_ubx("NAV", "TIMEGPS");
-
-  if (ubx::nav::timegps::type(nav_timegps))
+  if (times.received[3])
   {
-    ubx::nav::timegps parsed = ubx::nav::timegps(nav_timegps);
+    ubx::nav::timegps& parsed = times.get<ubx::nav::timegps>();
 
     std::cout << "iTOW: " << parsed.iTOW() << "ms" << std::endl;
     std::cout << "fTOD: " << parsed.fTOD() << "ns" << std::endl;
@@ -150,19 +140,14 @@ int main(int argc, char* argv[])
 
     std::cout << std::endl;
   }
-  else std::cout << "Type error" << std::endl;
+  else std::cout << "Not received" << std::endl;
   //GPS Demo End
 
   //UTC Demo
   std::cout << "TIMEUTC Demo" << std::endl;
-  x.ubx_send("NAV", "TIMEUTC");
-  sleep(2);
-
-  auto nav_timeutc = x.fetch_ubx("NAV", "TIMEUTC");
-
-  if (ubx::nav::timeutc::type(nav_timeutc))
+  if (times.received[4])
   {
-    ubx::nav::timeutc parsed = ubx::nav::timeutc(nav_timeutc);
+    ubx::nav::timeutc& parsed = times.get<ubx::nav::timeutc>();
 
     std::cout << "iTOW: " << parsed.iTOW() << "ms" << std::endl;
     std::cout << "tAcc: " << parsed.tAcc() << "ns" << std::endl;
@@ -210,6 +195,6 @@ int main(int argc, char* argv[])
 
     std::cout << std::endl;
   }
-  else std::cout << "Type error" << std::endl;
+  else std::cout << "Not received" << std::endl;
   //UTC Demo End
 }
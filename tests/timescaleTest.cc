@@ -0,0 +1,192 @@
+// Copyright (C) 2019 Colton Riedel
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see https://www.gnu.org/licenses/
+//
+// If you are interested in obtaining a copy of this program under a
+// different license, or have other questions or comments, contact me at
+//
+//   coltonriedel at protonmail dot ch
+
+#include <cracl/ublox/timescale.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Builds a NAV frame field by field, then appends the checksum
+class frame
+{
+  std::vector<uint8_t> m_data;
+
+public:
+  frame(uint8_t id, uint16_t length) : m_data(6 + length + 2)
+  {
+    m_data[0] = 0xb5;
+    m_data[1] = 0x62;
+    m_data[2] = 0x01;
+    m_data[3] = id;
+    m_data[4] = length & 0xff;
+    m_data[5] = length >> 8;
+  }
+
+  // Offset into the payload
+  template <typename T>
+  frame& set(size_t offset, T value)
+  {
+    std::memcpy(m_data.data() + 6 + offset, &value, sizeof (T));
+
+    return *this;
+  }
+
+  std::vector<uint8_t> finish()
+  {
+    uint8_t a = 0;
+    uint8_t b = 0;
+
+    for (size_t i = 2; i < m_data.size() - 2; ++i)
+    {
+      a += m_data[i];
+      b += a;
+    }
+
+    m_data[m_data.size() - 2] = a;
+    m_data[m_data.size() - 1] = b;
+
+    return m_data;
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  using namespace cracl;
+
+  const int64_t ns_per_s = 1000000000;
+
+  // The leap second at the end of 2016 (GPS - UTC 17 to 18), which took
+  //   effect at GPS week 1930, 18 s into the week
+  std::vector<std::vector<uint8_t>> messages;
+
+  // NAV-TIMEGPS an hour before, week 1929 TOW 601218 s, leap seconds valid
+  messages.push_back(frame(0x20, 16).set<uint32_t>(0, 601218000)
+      .set<int16_t>(8, 1929).set<int8_t>(10, 17).set<uint8_t>(11, 0x07)
+      .finish());
+
+  // NAV-TIMELS at the same time announcing +1 in 3600 s
+  messages.push_back(frame(0x26, 24).set<uint32_t>(0, 601218000)
+      .set<int8_t>(9, 17).set<int8_t>(11, 1).set<int32_t>(12, 3600)
+      .set<uint8_t>(23, 0x03).finish());
+
+  // NAV-TIMEGPS 10 s before, week 1930 TOW 8 s
+  messages.push_back(frame(0x20, 16).set<uint32_t>(0, 8000)
+      .set<int16_t>(8, 1930).set<int8_t>(10, 17).set<uint8_t>(11, 0x07)
+      .finish());
+
+  // NAV-TIMEGLO 6 s before, 2017-01-01 02:59:55 Moscow time (interval 6 from
+  //   1996, day 367)
+  messages.push_back(frame(0x23, 20).set<uint32_t>(0, 13000)
+      .set<uint32_t>(4, 10795).set<uint16_t>(12, 367).set<uint8_t>(14, 6)
+      .set<uint8_t>(15, 0x03).finish());
+
+  // NAV-TIMEBDS 5 s after without leap seconds, BDT week 574 SOW 9 s
+  messages.push_back(frame(0x24, 20).set<uint32_t>(0, 23000)
+      .set<uint32_t>(4, 9).set<int16_t>(12, 574).set<uint8_t>(15, 0x03)
+      .finish());
+
+  // NAV-TIMEGAL 10 s after, GST week 906 TOW 28 s, reporting the new value
+  messages.push_back(frame(0x25, 20).set<uint32_t>(0, 28000)
+      .set<uint32_t>(4, 28).set<int16_t>(12, 906).set<int8_t>(14, 18)
+      .set<uint8_t>(15, 0x07).finish());
+
+  struct expected
+  {
+    const char* name;
+    int64_t gps;
+    int64_t utc;
+  };
+
+  const int64_t event = 1930 * 604800 + 18;
+
+  const expected times[] = {
+    { "TIMEGPS", event - 3600, ubx::unix_seconds(2016, 12, 31, 23, 0, 1) },
+    { "TIMELS", 0, 0 },
+    { "TIMEGPS", event - 10, ubx::unix_seconds(2016, 12, 31, 23, 59, 51) },
+    { "TIMEGLO", event - 6, ubx::unix_seconds(2016, 12, 31, 23, 59, 55) },
+    { "TIMEBDS", event + 5, ubx::unix_seconds(2017, 1, 1, 0, 0, 5) },
+    { "TIMEGAL", event + 10, ubx::unix_seconds(2017, 1, 1, 0, 0, 10) }
+  };
+
+  ubx::timescale timescale;
+  std::vector<ubx::instant> results;
+
+  int failures = 0;
+
+  const size_t converted = timescale.convert(messages, results);
+
+  if (converted != messages.size() - 1)
+  {
+    std::cout << "Converted " << converted << " of " << messages.size() - 1
+      << " frames" << std::endl;
+
+    ++failures;
+  }
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const ubx::instant& t = results[i];
+    const expected& e = times[i];
+
+    std::cout << e.name << ": ";
+
+    if (e.gps == 0)
+    {
+      if (t.gps_valid || t.utc_valid)
+      {
+        std::cout << "converted, but carries no time" << std::endl;
+        ++failures;
+      }
+      else
+        std::cout << "OK" << std::endl;
+
+      continue;
+    }
+
+    if (!t.gps_valid || !t.utc_valid)
+    {
+      std::cout << "not valid" << std::endl;
+      ++failures;
+    }
+    else if (t.gps != e.gps * ns_per_s || t.utc != e.utc * ns_per_s)
+    {
+      std::cout << "GPS " << t.gps / ns_per_s << " s, expected " << e.gps
+        << " s, UTC " << t.utc / ns_per_s << " s, expected " << e.utc << " s"
+        << std::endl;
+      ++failures;
+    }
+    else
+      std::cout << "OK" << std::endl;
+  }
+
+  // The change was reported as taken, so nothing is pending any more
+  if (timescale.leap_seconds() != 18
+      || timescale.pending_change((event - 10) * ns_per_s) != 0)
+  {
+    std::cout << "Leap seconds " << timescale.leap_seconds()
+      << " after the change" << std::endl;
+    ++failures;
+  }
+
+  return failures;
+}